@@ -1,116 +1,2912 @@
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <complex>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <numeric>
+#include <string>
 #include <thread>
+#include <type_traits>
 #include <vector>
 #include <cmath>
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MANDELBROT_X86_SIMD 1
+#endif
+
+// Keeps a rarely taken path out of code that is meant to inline
+#if defined(__GNUC__) || defined(__clang__)
+#define MANDELBROT_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define MANDELBROT_NOINLINE __declspec(noinline)
+#else
+#define MANDELBROT_NOINLINE
+#endif
+
+// Long-lived workers that sleep between jobs. run() wakes every worker with
+// its index and returns once all of them have finished the job.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+    const std::function<void(int)>* job = nullptr;
+    uint64_t generation = 0;
+    int pending = 0;
+    bool stopping = false;
+
+    void workerLoop(int index) {
+        uint64_t seen = 0;
+        while (true) {
+            const std::function<void(int)>* current;
+            {
+                std::unique_lock lock(mutex);
+                jobReady.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                current = job;
+            }
+            
+            (*current)(index);
+            
+            std::lock_guard lock(mutex);
+            if (--pending == 0) {
+                jobDone.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(int numThreads) {
+        for (int i = 0; i < numThreads; ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    int size() const { return static_cast<int>(workers.size()); }
+    
+    void run(const std::function<void(int)>& task) {
+        std::unique_lock lock(mutex);
+        job = &task;
+        pending = size();
+        ++generation;
+        jobReady.notify_all();
+        jobDone.wait(lock, [&] { return pending == 0; });
+        job = nullptr;
+    }
+};
+
+// Handed to every loop that works on a render job. Checking it is a single
+// relaxed load, cheap enough for per-pixel loops; the job is cancelled as
+// soon as a newer job bumps the shared generation counter.
+class CancellationToken {
+private:
+    const std::atomic<uint64_t>* latest;
+    uint64_t generation;
+
+public:
+    CancellationToken(const std::atomic<uint64_t>& latestGeneration, uint64_t jobGeneration)
+        : latest(&latestGeneration), generation(jobGeneration) {}
+    
+    bool cancelled() const {
+        return latest->load(std::memory_order_relaxed) != generation;
+    }
+};
+
+struct Tile {
+    int x0, y0, x1, y1;
+    // Set on rectangles pushed by subdivision, whose edges are already computed
+    bool borderComputed = false;
+};
+
+// Per-worker tile deques. A worker pops from the back of its own deque and,
+// once that runs dry, steals from the front of the others, so workers whose
+// tiles escape early pick up the slow tiles of their neighbours. Workers may
+// push more tiles while processing one; every tile handed out by next() must
+// be reported back with finished().
+class TileScheduler {
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Tile> tiles;
+    };
+    
+    std::vector<Queue> queues;
+    // Tiles queued or still being processed
+    std::atomic<int> unfinished{0};
+
+public:
+    explicit TileScheduler(int numWorkers) : queues(numWorkers) {}
+    
+    // Splits the frame into tiles and deals each worker a contiguous run of them.
+    void reset(int width, int height, int tileSize) {
+        std::vector<Tile> tiles;
+        for (int y = 0; y < height; y += tileSize) {
+            for (int x = 0; x < width; x += tileSize) {
+                tiles.push_back({x, y, std::min(x + tileSize, width), std::min(y + tileSize, height)});
+            }
+        }
+        
+        const size_t numQueues = queues.size();
+        unfinished = static_cast<int>(tiles.size());
+        for (size_t i = 0; i < numQueues; ++i) {
+            std::lock_guard lock(queues[i].mutex);
+            queues[i].tiles.assign(tiles.begin() + tiles.size() * i / numQueues,
+                                   tiles.begin() + tiles.size() * (i + 1) / numQueues);
+        }
+    }
+    
+    // Queues a tile on the worker's own deque, where it is taken next
+    void push(int worker, const Tile& tile) {
+        unfinished++;
+        Queue& own = queues[worker];
+        std::lock_guard lock(own.mutex);
+        own.tiles.push_back(tile);
+    }
+    
+    void finished() {
+        unfinished--;
+    }
+    
+    // Returns false once every deque is empty and no tile is in progress
+    // that could still push more.
+    bool next(int worker, Tile& tile, bool& stolen) {
+        while (true) {
+            {
+                Queue& own = queues[worker];
+                std::lock_guard lock(own.mutex);
+                if (!own.tiles.empty()) {
+                    tile = own.tiles.back();
+                    own.tiles.pop_back();
+                    stolen = false;
+                    return true;
+                }
+            }
+            
+            const int numQueues = static_cast<int>(queues.size());
+            for (int i = 1; i < numQueues; ++i) {
+                Queue& victim = queues[(worker + i) % numQueues];
+                std::lock_guard lock(victim.mutex);
+                if (!victim.tiles.empty()) {
+                    tile = victim.tiles.front();
+                    victim.tiles.pop_front();
+                    stolen = true;
+                    return true;
+                }
+            }
+            
+            if (unfinished == 0) return false;
+            std::this_thread::yield();
+        }
+    }
+};
+
+// Double mantissa with a separate 64-bit exponent, mantissa * 2^exponent,
+// for zooms and perturbation deltas beyond the range of double. The
+// mantissa is kept in [1, 2) in magnitude, or 0. Normalizing rewrites its
+// exponent bits rather than calling frexp, so arithmetic costs a few
+// integer operations on top of the double ones.
+class FloatExp {
+private:
+    double mantissa = 0;
+    // Far enough below any real exponent that sums ignore zeros, and
+    // products of zeros cannot overflow
+    int64_t exponent = ZERO_EXPONENT;
+
+    static constexpr int64_t ZERO_EXPONENT = INT64_MIN / 4;
+    static constexpr uint64_t EXPONENT_BITS = 0x7ffull << 52;
+    static constexpr int64_t EXPONENT_BIAS = 1023;
+
+    // 2^-shift for shift in [0, 1022]
+    static double inversePowerOfTwo(int64_t shift) {
+        return std::bit_cast<double>(static_cast<uint64_t>(EXPONENT_BIAS - shift) << 52);
+    }
+
+    // 2^exponent for exponent in [-1022, 1023]
+    static double powerOfTwo(int64_t exponent) {
+        return std::bit_cast<double>(static_cast<uint64_t>(EXPONENT_BIAS + exponent) << 52);
+    }
+
+    static FloatExp normalized(double mantissa, int64_t exponent) {
+        const uint64_t bits = std::bit_cast<uint64_t>(mantissa);
+        const int64_t biased = static_cast<int64_t>((bits & EXPONENT_BITS) >> 52);
+        FloatExp result;
+        if (biased == 0) return mantissa == 0 ? result : normalizedSubnormal(mantissa, exponent);
+        result.mantissa = std::bit_cast<double>((bits & ~EXPONENT_BITS) | static_cast<uint64_t>(EXPONENT_BIAS) << 52);
+        result.exponent = exponent + biased - EXPONENT_BIAS;
+        return result;
+    }
+
+    // Scales a subnormal into the normal range first. Kept out of line so
+    // normalized() inlines into the arithmetic.
+    MANDELBROT_NOINLINE static FloatExp normalizedSubnormal(double mantissa, int64_t exponent) {
+        return normalized(mantissa * 0x1p64, exponent - 64);
+    }
+
+    friend class FixedPoint;
+
+public:
+    FloatExp() = default;
+    FloatExp(double value) : FloatExp(normalized(value, 0)) {}
+    FloatExp(double mantissa, int64_t exponent) : FloatExp(normalized(mantissa, exponent)) {}
+
+    // Rounds to 0 or infinity outside the range of double
+    double toDouble() const {
+        if (exponent >= -1022 && exponent <= 1023) return mantissa * powerOfTwo(exponent);
+        if (exponent < -1100) return mantissa * 0.0;
+        if (exponent > 1100) return mantissa * HUGE_VAL;
+        return std::ldexp(mantissa, static_cast<int>(exponent));
+    }
+
+    double log2() const { return static_cast<double>(exponent) + std::log2(std::abs(mantissa)); }
+    // floor(log2 |x|) like std::ilogb, far below any real value's for 0
+    int64_t ilogb() const { return exponent; }
+
+    FloatExp operator-() const {
+        FloatExp result = *this;
+        result.mantissa = -mantissa;
+        return result;
+    }
+
+    friend FloatExp operator+(const FloatExp& a, const FloatExp& b) {
+        const bool aLarger = a.exponent >= b.exponent;
+        const FloatExp& larger = aLarger ? a : b;
+        const FloatExp& smaller = aLarger ? b : a;
+        const int64_t shift = larger.exponent - smaller.exponent;
+        if (shift > 64) return larger;
+        return normalized(larger.mantissa + smaller.mantissa * inversePowerOfTwo(shift), larger.exponent);
+    }
+
+    friend FloatExp operator-(const FloatExp& a, const FloatExp& b) { return a + -b; }
+
+    friend FloatExp operator*(const FloatExp& a, const FloatExp& b) {
+        return normalized(a.mantissa * b.mantissa, a.exponent + b.exponent);
+    }
+
+    friend FloatExp operator/(const FloatExp& a, const FloatExp& b) {
+        return normalized(a.mantissa / b.mantissa, a.exponent - b.exponent);
+    }
+
+    FloatExp& operator+=(const FloatExp& other) { return *this = *this + other; }
+    FloatExp& operator-=(const FloatExp& other) { return *this = *this - other; }
+    FloatExp& operator*=(const FloatExp& other) { return *this = *this * other; }
+    FloatExp& operator/=(const FloatExp& other) { return *this = *this / other; }
+
+    // Zeros and mixed signs are ordered by the mantissas alone
+    friend bool operator<(const FloatExp& a, const FloatExp& b) {
+        if ((a.mantissa < 0) != (b.mantissa < 0) || a.mantissa == 0 || b.mantissa == 0) {
+            return a.mantissa < b.mantissa;
+        }
+        if (a.exponent != b.exponent) return (a.exponent < b.exponent) != (a.mantissa < 0);
+        return a.mantissa < b.mantissa;
+    }
+
+    friend bool operator>(const FloatExp& a, const FloatExp& b) { return b < a; }
+    friend bool operator<=(const FloatExp& a, const FloatExp& b) { return !(b < a); }
+    friend bool operator>=(const FloatExp& a, const FloatExp& b) { return !(a < b); }
+    friend bool operator==(const FloatExp& a, const FloatExp& b) {
+        return a.mantissa == b.mantissa && (a.mantissa == 0 || a.exponent == b.exponent);
+    }
+
+    // Like a double, with the decimal exponent taken from the binary one
+    // when the value does not fit
+    friend std::ostream& operator<<(std::ostream& out, const FloatExp& value) {
+        if (value.mantissa == 0 || std::abs(value.exponent) < 1000) return out << value.toDouble();
+        const double decimal = value.log2() * std::log10(2.0);
+        const double exponent10 = std::floor(decimal);
+        return out << std::copysign(std::pow(10.0, decimal - exponent10), value.mantissa) << "e"
+                   << static_cast<int64_t>(exponent10);
+    }
+};
+
+// Signed fixed-point number with one 32-bit integer limb and any number of
+// 32-bit fraction limbs, for the view center and the reference orbit of deep
+// zooms. Their values stay small, so the integer limb simply wraps on
+// overflow. Mixed-precision operations work at the larger precision;
+// multiplication truncates toward zero.
+class FixedPoint {
+private:
+    // Magnitude, least significant limb first; the last limb is the integer part
+    std::vector<uint32_t> limbs;
+    bool negative = false;
+
+    static constexpr double LIMB_SCALE = 4294967296.0;
+
+    static int compareMagnitude(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    // result = larger - smaller on magnitudes of equal precision; result may
+    // be either operand
+    static void subtractMagnitude(std::vector<uint32_t>& result, const std::vector<uint32_t>& larger,
+                                  const std::vector<uint32_t>& smaller) {
+        int64_t borrow = 0;
+        for (size_t i = 0; i < result.size(); ++i) {
+            const int64_t difference = static_cast<int64_t>(larger[i]) - smaller[i] - borrow;
+            result[i] = static_cast<uint32_t>(difference);
+            borrow = difference < 0;
+        }
+    }
+
+    bool isZero() const {
+        return std::all_of(limbs.begin(), limbs.end(), [](uint32_t limb) { return limb == 0; });
+    }
+
+    void divideBy(uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            const uint64_t current = remainder << 32 | limbs[i];
+            limbs[i] = static_cast<uint32_t>(current / divisor);
+            remainder = current % divisor;
+        }
+    }
+
+    void add(const FixedPoint& other, bool subtract) {
+        if (other.precision() != precision()) {
+            FixedPoint widened = other;
+            widened.setPrecision(std::max(precision(), other.precision()));
+            setPrecision(widened.precision());
+            add(widened, subtract);
+            return;
+        }
+
+        const bool otherNegative = other.negative != subtract;
+        if (negative == otherNegative) {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < limbs.size(); ++i) {
+                carry += static_cast<uint64_t>(limbs[i]) + other.limbs[i];
+                limbs[i] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+        } else if (compareMagnitude(limbs, other.limbs) >= 0) {
+            subtractMagnitude(limbs, limbs, other.limbs);
+        } else {
+            subtractMagnitude(limbs, other.limbs, limbs);
+            negative = otherNegative;
+        }
+        if (isZero()) negative = false;
+    }
+
+public:
+    FixedPoint(double value = 0.0, int fractionLimbs = 2) : limbs(fractionLimbs + 1), negative(value < 0) {
+        double magnitude = std::abs(value);
+        for (size_t i = limbs.size(); i-- > 0;) {
+            const double limb = std::floor(magnitude);
+            limbs[i] = static_cast<uint32_t>(limb);
+            magnitude = (magnitude - limb) * LIMB_SCALE;
+        }
+    }
+
+    // Limbs above the value's leading bit stay zero; from the first limb
+    // holding part of it on, its digits are peeled off as for doubles
+    FixedPoint(const FloatExp& value, int fractionLimbs) : limbs(fractionLimbs + 1), negative(value.mantissa < 0) {
+        if (value.mantissa == 0) return;
+        const int64_t leading = std::max<int64_t>(0, (-value.exponent + 31) / 32);
+        if (leading > fractionLimbs) {
+            negative = false;
+            return;
+        }
+        double magnitude = std::ldexp(std::abs(value.mantissa), static_cast<int>(value.exponent + 32 * leading));
+        for (size_t i = limbs.size() - leading; i-- > 0;) {
+            const double limb = std::floor(magnitude);
+            limbs[i] = static_cast<uint32_t>(limb);
+            magnitude = (magnitude - limb) * LIMB_SCALE;
+        }
+    }
+
+    // Parses a plain decimal such as "-0.7436438870371587047521915"
+    static FixedPoint parse(const std::string& text, int fractionLimbs) {
+        FixedPoint result(0.0, fractionLimbs);
+        size_t start = 0;
+        if (!text.empty() && (text[0] == '-' || text[0] == '+')) start = 1;
+        const size_t point = std::min(text.find('.'), text.size());
+        auto digit = [&](size_t i) {
+            if (text[i] < '0' || text[i] > '9') throw std::invalid_argument("Not a decimal number: " + text);
+            return static_cast<uint32_t>(text[i] - '0');
+        };
+
+        // The fraction from its last digit on: x = (x + digit) / 10
+        for (size_t i = text.size(); i-- > point + 1;) {
+            result.limbs.back() += digit(i);
+            result.divideBy(10);
+        }
+        for (size_t i = start; i < point; ++i) {
+            result.limbs.back() = result.limbs.back() * 10 + digit(i);
+        }
+        result.negative = text[0] == '-' && !result.isZero();
+        return result;
+    }
+
+    int precision() const { return static_cast<int>(limbs.size()) - 1; }
+
+    // Adds or drops fraction limbs at the least significant end
+    void setPrecision(int fractionLimbs) {
+        const int change = fractionLimbs - precision();
+        if (change > 0) {
+            limbs.insert(limbs.begin(), change, 0);
+        } else if (change < 0) {
+            limbs.erase(limbs.begin(), limbs.begin() - change);
+            if (isZero()) negative = false;
+        }
+    }
+
+    double toDouble() const {
+        double value = 0;
+        for (size_t i = 0; i + 1 < limbs.size(); ++i) {
+            value = (value + limbs[i]) / LIMB_SCALE;
+        }
+        value += limbs.back();
+        return negative ? -value : value;
+    }
+
+    // Exact to double precision however small the value is
+    FloatExp toFloatExp() const {
+        size_t top = limbs.size();
+        while (top > 0 && limbs[top - 1] == 0) top--;
+        if (top == 0) return {};
+        double value = 0;
+        for (size_t i = top >= 3 ? top - 3 : 0; i < top; ++i) {
+            value = value / LIMB_SCALE + limbs[i];
+        }
+        const int64_t exponent = 32 * (static_cast<int64_t>(top) - static_cast<int64_t>(limbs.size()));
+        return {negative ? -value : value, exponent};
+    }
+
+    // Decimal with the given number of fraction digits, truncated
+    std::string toString(int digits) const {
+        std::string text = (negative ? "-" : "") + std::to_string(limbs.back()) + ".";
+        std::vector<uint32_t> fraction(limbs.begin(), limbs.end() - 1);
+        for (int d = 0; d < digits; ++d) {
+            uint64_t carry = 0;
+            for (uint32_t& limb : fraction) {
+                carry += static_cast<uint64_t>(limb) * 10;
+                limb = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            text += static_cast<char>('0' + carry);
+        }
+        return text;
+    }
+
+    // result = a * b for operands of equal precision; result may be either
+    // operand. Used by the reference orbit loop to avoid reallocating.
+    static void multiply(const FixedPoint& a, const FixedPoint& b, FixedPoint& result) {
+        const size_t n = a.limbs.size();
+        thread_local std::vector<uint32_t> product;
+        product.assign(2 * n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < n; ++j) {
+                carry += static_cast<uint64_t>(a.limbs[i]) * b.limbs[j] + product[i + j];
+                product[i + j] = static_cast<uint32_t>(carry);
+                carry >>= 32;
+            }
+            product[i + n] = static_cast<uint32_t>(carry);
+        }
+
+        const bool negative = a.negative != b.negative;
+        result.limbs.assign(product.begin() + (n - 1), product.begin() + (2 * n - 1));
+        result.negative = negative && !result.isZero();
+    }
+
+    FixedPoint& operator+=(const FixedPoint& other) {
+        add(other, false);
+        return *this;
+    }
+
+    FixedPoint& operator-=(const FixedPoint& other) {
+        add(other, true);
+        return *this;
+    }
+
+    FixedPoint& operator+=(double value) { return *this += FixedPoint(value, precision()); }
+    FixedPoint& operator-=(double value) { return *this -= FixedPoint(value, precision()); }
+    FixedPoint& operator+=(const FloatExp& value) { return *this += FixedPoint(value, precision()); }
+    FixedPoint& operator-=(const FloatExp& value) { return *this -= FixedPoint(value, precision()); }
+
+    friend FixedPoint operator+(FixedPoint a, const FixedPoint& b) { return a += b; }
+    friend FixedPoint operator-(FixedPoint a, const FixedPoint& b) { return a -= b; }
+
+    friend FixedPoint operator*(const FixedPoint& a, const FixedPoint& b) {
+        if (a.precision() != b.precision()) {
+            FixedPoint wideA = a, wideB = b;
+            const int precision = std::max(a.precision(), b.precision());
+            wideA.setPrecision(precision);
+            wideB.setPrecision(precision);
+            return wideA * wideB;
+        }
+        FixedPoint result;
+        multiply(a, b, result);
+        return result;
+    }
+};
+
 class MandelbrotExplorer {
 private:
     static constexpr int WINDOW_WIDTH = 800;
     static constexpr int WINDOW_HEIGHT = 600;
-    static constexpr int MAX_ITERATIONS = 1000;
+    // The iteration limit is picked per frame: MIN_ITERATIONS plus
+    // ITERATIONS_PER_OCTAVE for every doubling of the zoom, raised further
+    // while the previous frame had many pixels escaping just below its limit.
+    // --benchmark and --verify use REFERENCE_ITERATIONS.
+    static constexpr int MIN_ITERATIONS = 256;
+    static constexpr int ITERATIONS_PER_OCTAVE = 100;
+    static constexpr int MAX_ITERATION_LIMIT = 1 << 20;
+    static constexpr int REFERENCE_ITERATIONS = 1000;
+    // Share of pixels escaping in the top half of the limit above which
+    // the next frame doubles it
+    static constexpr double SLOW_ESCAPE_FRACTION = 1e-3;
+    static constexpr int TILE_SIZE = 32;
+    // Subdivision computes rectangles this narrow pixel by pixel
+    static constexpr int MIN_SUBDIVISION_SIZE = 6;
+    // Sample spacing of the progressive passes, coarsest first. Each pass
+    // halves the previous spacing; TILE_SIZE must be a multiple of the first.
+    static constexpr int PROGRESSIVE_STEPS[] = {4, 2, 1};
+    static constexpr double ZOOM_PER_NOTCH = 1.1;
+    // Time constant of the exponential approach to the zoom target
+    static constexpr double ZOOM_SMOOTHING_MS = 60.0;
+    static constexpr double DISPLAY_FRAME_MS = 1000.0 / 60.0;
+    // Frames rendered while dragging or zooming should fit in this time; the
+    // render resolution drops by up to MAX_RESOLUTION_DIVISOR per axis to keep
+    // them there. After INTERACTION_IDLE_MS without input the view is
+    // rendered again at full resolution.
+    static constexpr double FRAME_BUDGET_MS = DISPLAY_FRAME_MS;
+    static constexpr int MAX_RESOLUTION_DIVISOR = 4;
+    static constexpr double INTERACTION_IDLE_MS = 150.0;
+    // Palette scale before the density setting; equalized coloring spans one
+    // cycle over all escaped pixels instead
+    static constexpr double ITERATIONS_PER_PALETTE_CYCLE = 32.0;
+    static constexpr double PALETTE_DENSITY_STEP = 1.25;
+    static constexpr double COLOR_CYCLES_PER_SECOND = 0.1;
+    // Colors are looked up in a table of PALETTE_SIZE entries (a power of
+    // two, so positions wrap with a mask) by fixed-point positions with
+    // PALETTE_FRACTION_BITS below the entry index
+    static constexpr int PALETTE_SIZE = 1024;
+    static constexpr int PALETTE_FRACTION_BITS = 8;
+
+    // Copy upload writes the frame to tempPixels and SDL_UpdateTexture reads it back
+    static constexpr uint64_t FRAME_BYTES_SAVED = 2ull * WINDOW_WIDTH * WINDOW_HEIGHT * sizeof(uint32_t);
+    
+    static constexpr double ESCAPE_RADIUS_SQUARED = 4.0;
+    
+    // Views zoomed in further than this are rendered by perturbation against
+    // a reference orbit computed in fixed point. The view center keeps
+    // PRECISION_GUARD_BITS more than the pixel spacing needs.
+    static constexpr double PERTURBATION_ZOOM = 1e10;
+    static constexpr int PRECISION_GUARD_BITS = 64;
+    // Perturbed pixels whose |z| falls below this share of the reference
+    // orbit's |Z| have lost too much precision, squared
+    static constexpr double GLITCH_TOLERANCE_SQUARED = 1e-3 * 1e-3;
+    // Past this zoom pixel offsets near double's underflow, and deltas are
+    // iterated as FloatExp until either component reaches
+    // 2^DOUBLE_DELTA_EXPONENT. From there on the offsets, and a smaller
+    // component that underflows, are below double's rounding of the deltas.
+    static constexpr double EXTENDED_RANGE_ZOOM = 1e290;
+    static constexpr int DOUBLE_DELTA_EXPONENT = -900;
+    // Perturbed pixels skip their first iterations with a polynomial of
+    // SERIES_TERMS terms in their offset, for as long as it stays within
+    // SERIES_TOLERANCE of the exact delta at the corners of the view
+    static constexpr int SERIES_TERMS = 8;
+    static constexpr double SERIES_TOLERANCE = 1e-9;
+    // Bilinear approximation drops d^2 from d' = 2Zd + d^2 + dc while it is
+    // below this share of 2Zd. The dropped terms add up over a merged run,
+    // so anything looser than double rounding changes chaotic pixels.
+    static constexpr double BILINEAR_TOLERANCE = 1.0 / (1ull << 53);
+    
+    // Orbits closer than this to a saved point are treated as periodic
+    static constexpr double PERIODICITY_EPSILON = 1e-10;
+    
+    // Optional shortcuts compiled into the kernels
+    enum KernelFeature {
+        INTERIOR_CHECK = 1,
+        PERIODICITY_CHECK = 2,
+        ALL_KERNEL_FEATURES = INTERIOR_CHECK | PERIODICITY_CHECK
+    };
+    
+    // How the pixels of a tile are found. Brute force runs the kernel on
+    // every pixel; subdivision (Mariani-Silver) computes the border of a
+    // rectangle and fills it if the border has a single escape time and
+    // period, since the set is connected, and otherwise splits it in four.
+    // It is approximate: features smaller than a pixel can slip through a
+    // uniform border and are filled over.
+    // Boundary tracing only computes pixels along the edges between regions
+    // of equal escape time and period, then fills the enclosed pixels.
+    enum FillMode {
+        BRUTE_FORCE,
+        SUBDIVISION,
+        BOUNDARY_TRACE,
+        FILL_MODE_COUNT
+    };
+    static constexpr const char* FILL_MODE_NAMES[FILL_MODE_COUNT] = {
+        "brute force", "rectangle subdivision", "boundary tracing"
+    };
+    
+    // Row kernels compute escape times for `count` points sharing one imaginary
+    // part, the period of interior points whose cycle was found (0 for the
+    // rest) and |z|^2 of the first orbit point outside the escape radius.
+    // All variants must agree with calculateMandelbrotReference. They check
+    // the token once per pixel or lane group and return early when cancelled,
+    // leaving the remaining outputs unset.
+    using RowKernel = void (*)(const double* real, double imag, int count, int maxIterations,
+                               int* iterations, int* periods, float* norms, const CancellationToken& cancel);
+    
+    // Palette position of every escape time of a frame, as fixed-point
+    // indices into the palette table. Positions wrap around at 2^32, which
+    // is a whole number of palette cycles.
+    struct PaletteIndex {
+        const uint32_t* positions;
+        const uint32_t* palette;
+        int maxIterations;
+        bool smooth;
+        bool interpolate;
+    };
+    
+    // Colors `count` pixels from their escape times, or from their smooth
+    // iteration counts by interpolating between neighboring positions
+    using ColorizeKernel = void (*)(const int* iterations, const float* smooth, const uint8_t* interior,
+                                    int count, const PaletteIndex& index, uint32_t* colors);
+    
+    struct View {
+        FixedPoint centerX;
+        FixedPoint centerY;
+        FloatExp zoom;
+    };
+    
+    // Orbit of one point computed in fixed point, for perturbation
+    // rendering: Z_0 = 0 up to the first point outside the escape radius,
+    // or up to maxIterations if the point did not escape
+    struct ReferenceOrbit {
+        FixedPoint centerX;
+        FixedPoint centerY;
+        std::vector<double> real;
+        std::vector<double> imag;
+        int maxIterations = 0;
+        bool escaped = false;
+        
+        int length() const { return static_cast<int>(real.size()); }
+    };
+    
+    // Series approximation of the perturbation delta after the first skip
+    // iterations, d = scale * sum over k of coefficients[k] (p / radius)^(k+1),
+    // for a pixel p pixels from the reference point. radius is the largest
+    // such offset in the view; with it and the common scale the
+    // coefficients stay within double range at any zoom.
+    struct SeriesApproximation {
+        int skip = 0;
+        double radius = 1;
+        FloatExp scale;
+        std::array<std::complex<double>, SERIES_TERMS> coefficients{};
+    };
+    
+    // A run of perturbation steps approximated as d -> a d + b dc, which
+    // holds while |d| < radius at its start
+    struct BilinearStep {
+        std::complex<double> a;
+        std::complex<double> b;
+        double radius;
+    };
+    
+    // Bilinear approximations of the reference orbit: levels[k][j] covers
+    // the 2^(k+1) steps from reference index 1 + j 2^(k+1). Single steps
+    // save nothing and are not stored. Built for pixels up to dcRadius from
+    // the reference point, then only read by the workers.
+    struct BilinearTable {
+        FloatExp dcRadius;
+        std::vector<std::vector<BilinearStep>> levels;
+    };
+    
+    // Destination of a frame: the rows of tempPixels or of a locked texture
+    struct FrameTarget {
+        uint8_t* pixels;
+        int pitch;
+        
+        uint32_t* row(int y) const {
+            return reinterpret_cast<uint32_t*>(pixels + static_cast<ptrdiff_t>(y) * pitch);
+        }
+    };
+    
+    // Load balance of the last frame, per worker
+    struct WorkerStats {
+        double busyMs = 0;
+        double idleMs = 0;
+        int tiles = 0;
+        int stolen = 0;
+        int pixels = 0;
+        // Perturbed pixels rebased after losing precision
+        int glitches = 0;
+    };
+    
+    struct FrameStats {
+        double frameMs = 0;
+        // Until the first progressive pass could be shown, 0 without one
+        double firstPassMs = 0;
+        double colorizeMs = 0;
+        // Perturbation only: the reference orbit's length, and the time to
+        // compute it, 0 when it was reused
+        int referenceIterations = 0;
+        double referenceMs = 0;
+        // Iterations every pixel skipped by series approximation
+        int seriesSkip = 0;
+        double seriesMs = 0;
+        // Levels of the bilinear table, and the time to build it, 0 when
+        // it was reused
+        int bilinearLevels = 0;
+        double bilinearMs = 0;
+        // Whether the deltas were FloatExp
+        bool extendedRange = false;
+        int glitchedPixels = 0;
+        int resolutionDivisor = 1;
+        int iterationLimit = 0;
+        int slowEscapes = 0;
+        int pixelsComputed = 0;
+        std::vector<WorkerStats> workers;
+    };
+    
+    SDL_Window* window = nullptr;
+    SDL_Renderer* renderer = nullptr;
+    // Zero-copy upload alternates between two streaming textures: the render
+    // thread writes into the locked back texture while the front one is shown.
+    SDL_Texture* textures[2] = {};
+    int frontTexture = 0;
+    std::vector<uint32_t> pixels;
+    std::vector<uint32_t> tempPixels;
+    
+    // View parameters, owned by the UI thread
+    // The center gains precision as the zoom deepens
+    FixedPoint centerX{-0.5};
+    FixedPoint centerY{0.0};
+    FloatExp zoom = 1.0;
+    
+    // Input is drained in batches: handlers only fold drag and zoom into the
+    // view and set viewChanged, and each batch posts at most one request
+    SDL_Point dragStart{};
+    SDL_Point dragCurrent{};
+    // Drag in screen pixels not applied to the view yet
+    double dragRemainderX = 0;
+    double dragRemainderY = 0;
+    bool isDragging = false;
+    bool viewChanged = false;
+    int inputEvents = 0;
+    int renderRequests = 0;
+    
+    // Drag and zoom requests are interactive and may be rendered at reduced
+    // resolution; fullResolutionPending is set until the full-resolution
+    // frame has been requested after input went idle
+    bool interactiveChange = false;
+    bool fullResolutionPending = false;
+    std::chrono::steady_clock::time_point lastInteraction;
+    
+    // Wheel zoom is animated: every displayed frame moves zoom part of the way
+    // to zoomTarget, keeping the point under zoomAnchor fixed on screen. More
+    // wheel ticks only move the target.
+    bool zoomAnimating = false;
+    FloatExp zoomTarget = 1.0;
+    SDL_Point zoomAnchor{};
+    std::chrono::steady_clock::time_point lastZoomStep;
+    
+    // Zero-copy upload has workers write into the locked streaming texture
+    // instead of tempPixels, skipping the intermediate buffer and the copy
+    // made by SDL_UpdateTexture.
+    bool zeroCopyUpload = true;
+    bool lastFrameZeroCopy = false;
+    // Bytes not copied for the frame shown last, and for all frames so far
+    uint64_t lastFrameBytesSaved = 0;
+    uint64_t uploadBytesSaved = 0;
+    
+    // Colors interior pixels by the period their orbit settled into
+    std::atomic<bool> showPeriods{false};
+    std::atomic<FillMode> fillMode{BRUTE_FORCE};
+    // Full brute-force recomputes show coarse passes before the full frame
+    std::atomic<bool> progressive{true};
+    // Manual iteration limit, 0 to pick it per frame
+    std::atomic<int> iterationOverride{0};
+    
+    // Palette settings. Changing them only re-runs the colorize pass.
+    std::atomic<bool> smoothColoring{false};
+    std::atomic<bool> histogramEqualization{false};
+    std::atomic<bool> paletteInterpolation{true};
+    std::atomic<double> paletteDensity{1.0};
+    std::atomic<double> colorCycle{0.0};
+    // Color cycling advances colorCycle with every displayed frame
+    bool colorCycling = false;
+    std::chrono::steady_clock::time_point lastCycleStep;
+    
+    RowKernel rowKernel = calculateRowScalar<ALL_KERNEL_FEATURES>;
+    ColorizeKernel colorizeKernel = colorizeRowScalar;
+    ThreadPool pool;
+    TileScheduler scheduler;
+    
+    // Render thread state. The escape times of the last frame and the view
+    // they were computed for are kept so a pan only has to compute the newly
+    // exposed strips; validRegion is the part of the buffer still up to date.
+    std::vector<int> iterationBuffer;
+    std::vector<int> periodBuffer;
+    // Final |z|^2, the smooth iteration count derived from it, and whether
+    // the pixel reached the iteration limit
+    std::vector<float> normBuffer;
+    std::vector<float> smoothBuffer;
+    std::vector<uint8_t> interiorBuffer;
+    // Cumulative share of escaped pixels below each iteration count, for
+    // histogram equalization; histogram is its scratch space
+    std::vector<int> histogram;
+    std::vector<float> equalization;
+    std::vector<uint32_t> palettePositions;
+    View renderedView{};
+    ReferenceOrbit referenceOrbit;
+    BilinearTable bilinearTable;
+    FillMode renderedFillMode = BRUTE_FORCE;
+    int renderedDivisor = 1;
+    int renderedIterations = 0;
+    Tile validRegion{};
+    std::vector<WorkerStats> workerStats;
+    
+    // Estimated time of a full-resolution frame of the current view, from the
+    // last full recompute or a cancelled frame that took longer, and the
+    // divisor used for the last interactive frame
+    double fullFrameMs = 0;
+    int resolutionDivisor = 1;
+    
+    // Escape statistics of the last finished frame: its iteration limit,
+    // pixels that escaped in the top half of it, and the slowest escape.
+    // Cancelled frames leave them alone, so they don't move the limit.
+    int finishedIterations = 0;
+    int slowEscapes = 0;
+    int slowestEscape = 0;
+    
+    // Render requests from the UI thread. Every request (and shutdown) bumps
+    // latestGeneration, which cancels the job currently rendering.
+    std::thread renderThread;
+    std::mutex requestMutex;
+    std::condition_variable requestCondition;
+    View requestedView{};
+    bool requestedInteractive = false;
+    bool requestPending = false;
+    std::atomic<uint64_t> latestGeneration{0};
+    bool stopping = false;
+    
+    // Frame handoff, guarded by frameMutex. The UI thread provides backTarget,
+    // the render thread fills it and sets frameReady, then posts frameReadyEvent.
+    // The event's code is 1 for a finished frame, 0 for a coarse progressive pass.
+    std::mutex frameMutex;
+    std::condition_variable frameCondition;
+    FrameTarget backTarget{};
+    bool backTargetLocked = false;
+    bool frameInProgress = false;
+    bool frameReady = false;
+    Uint32 frameReadyEvent = 0;
+    // Frames at reduced resolution fill the top-left of the texture, and
+    // SDL scales that part up to the window
+    int readyDivisor = 1;
+    int frontDivisor = 1;
+    
+    std::mutex statsMutex;
+    FrameStats lastFrameStats;
+    int framesCompleted = 0;
+    int framesCancelled = 0;
+    double cancelledMs = 0;
+
+    // Distinct hues for the first few periods, cycling after that
+    static uint32_t getPeriodColor(int period) {
+        static constexpr uint32_t palette[] = {
+            0x3050A0, 0xA03050, 0x30A050, 0xA0A030, 0x8030A0, 0x30A0A0, 0xA06030, 0x606060
+        };
+        return palette[(period - 1) % std::size(palette)];
+    }
+
+    // Palette settings, read once per frame
+    struct Coloring {
+        bool smooth;
+        bool equalize;
+        bool interpolate;
+        double density;
+        double cycle;
+    };
+    
+    // One palette cycle per position unit
+    static uint32_t paletteColor(double position) {
+        double hue = std::fmod(position, 1.0);
+        
+        // Better color distribution
+        double r = std::abs(std::sin(2 * M_PI * (hue + 0.0/3.0)));
+        double g = std::abs(std::sin(2 * M_PI * (hue + 1.0/3.0)));
+        double b = std::abs(std::sin(2 * M_PI * (hue + 2.0/3.0)));
+        
+        return static_cast<uint32_t>(r * 255) << 16 |
+               static_cast<uint32_t>(g * 255) << 8 |
+               static_cast<uint32_t>(b * 255);
+    }
+    
+    // One palette cycle sampled into PALETTE_SIZE entries, plus a copy of
+    // the first entry so interpolation never has to wrap
+    static const uint32_t* paletteTable() {
+        static const auto table = [] {
+            std::array<uint32_t, PALETTE_SIZE + 1> entries;
+            for (int i = 0; i < PALETTE_SIZE; ++i) {
+                entries[i] = paletteColor(static_cast<double>(i) / PALETTE_SIZE);
+            }
+            entries[PALETTE_SIZE] = entries[0];
+            return entries;
+        }();
+        return table.data();
+    }
+    
+    // The fraction bits of a position are the blend weight between two
+    // neighboring palette entries
+    static uint32_t paletteLookup(uint32_t position, const PaletteIndex& index) {
+        const uint32_t entry = position >> PALETTE_FRACTION_BITS & (PALETTE_SIZE - 1);
+        const uint32_t a = index.palette[entry];
+        if (!index.interpolate) return a;
+        
+        const uint32_t b = index.palette[entry + 1];
+        const uint32_t weight = position & ((1 << PALETTE_FRACTION_BITS) - 1);
+        const uint32_t rb = ((a & 0xFF00FF) * (256 - weight) + (b & 0xFF00FF) * weight) >> 8 & 0xFF00FF;
+        const uint32_t g = ((a & 0x00FF00) * (256 - weight) + (b & 0x00FF00) * weight) >> 8 & 0x00FF00;
+        return rb | g;
+    }
+    
+    static void colorizeRowScalar(const int* iterations, const float* smooth, const uint8_t* interior,
+                                  int count, const PaletteIndex& index, uint32_t* colors) {
+        for (int x = 0; x < count; ++x) {
+            if (interior[x]) {
+                colors[x] = 0;
+                continue;
+            }
+            uint32_t position;
+            if (index.smooth) {
+                const float s = std::clamp(smooth[x], 0.0f, static_cast<float>(index.maxIterations - 1));
+                const int n = static_cast<int>(s);
+                const int32_t span = static_cast<int32_t>(index.positions[n + 1] - index.positions[n]);
+                position = index.positions[n] + static_cast<int32_t>((s - n) * static_cast<float>(span));
+            } else {
+                position = index.positions[iterations[x]];
+            }
+            colors[x] = paletteLookup(position, index);
+        }
+    }
+    
+#ifdef MANDELBROT_X86_SIMD
+    // 8 pixels per step with gathers from the position and palette tables;
+    // the same arithmetic as colorizeRowScalar, so the output is identical
+    __attribute__((target("avx2")))
+    static void colorizeRowAvx2(const int* iterations, const float* smooth, const uint8_t* interior,
+                                int count, const PaletteIndex& index, uint32_t* colors) {
+        const int* positions = reinterpret_cast<const int*>(index.positions);
+        const int* palette = reinterpret_cast<const int*>(index.palette);
+        const __m256 top = _mm256_set1_ps(static_cast<float>(index.maxIterations - 1));
+        const __m256i entryMask = _mm256_set1_epi32(PALETTE_SIZE - 1);
+        const __m256i weightMask = _mm256_set1_epi32((1 << PALETTE_FRACTION_BITS) - 1);
+        const __m256i full = _mm256_set1_epi32(256);
+        const __m256i rbMask = _mm256_set1_epi32(0xFF00FF);
+        const __m256i gMask = _mm256_set1_epi32(0x00FF00);
+        
+        int x = 0;
+        for (; x + 8 <= count; x += 8) {
+            __m256i position;
+            if (index.smooth) {
+                const __m256 s = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(smooth + x), _mm256_setzero_ps()), top);
+                const __m256i n = _mm256_cvttps_epi32(s);
+                const __m256 fraction = _mm256_sub_ps(s, _mm256_cvtepi32_ps(n));
+                const __m256i low = _mm256_i32gather_epi32(positions, n, 4);
+                const __m256i span = _mm256_sub_epi32(_mm256_i32gather_epi32(positions + 1, n, 4), low);
+                position = _mm256_add_epi32(low, _mm256_cvttps_epi32(_mm256_mul_ps(fraction, _mm256_cvtepi32_ps(span))));
+            } else {
+                const __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(iterations + x));
+                position = _mm256_i32gather_epi32(positions, n, 4);
+            }
+            
+            const __m256i entry = _mm256_and_si256(_mm256_srli_epi32(position, PALETTE_FRACTION_BITS), entryMask);
+            __m256i color = _mm256_i32gather_epi32(palette, entry, 4);
+            if (index.interpolate) {
+                const __m256i next = _mm256_i32gather_epi32(palette + 1, entry, 4);
+                const __m256i weight = _mm256_and_si256(position, weightMask);
+                const __m256i inverse = _mm256_sub_epi32(full, weight);
+                const __m256i rb = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_and_si256(color, rbMask), inverse),
+                                                    _mm256_mullo_epi32(_mm256_and_si256(next, rbMask), weight));
+                const __m256i g = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_and_si256(color, gMask), inverse),
+                                                   _mm256_mullo_epi32(_mm256_and_si256(next, gMask), weight));
+                color = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(rb, 8), rbMask),
+                                        _mm256_and_si256(_mm256_srli_epi32(g, 8), gMask));
+            }
+            
+            const __m256i inside = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(interior + x)));
+            color = _mm256_andnot_si256(_mm256_cmpgt_epi32(inside, _mm256_setzero_si256()), color);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(colors + x), color);
+        }
+        colorizeRowScalar(iterations + x, smooth + x, interior + x, count - x, index, colors + x);
+    }
+#endif
+
+    // Colorize kernels the host can run, widest instruction set first
+    static std::vector<std::pair<const char*, ColorizeKernel>> supportedColorizeKernels() {
+        std::vector<std::pair<const char*, ColorizeKernel>> kernels;
+#ifdef MANDELBROT_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            kernels.emplace_back("AVX2", colorizeRowAvx2);
+        }
+#endif
+        kernels.emplace_back("scalar", colorizeRowScalar);
+        return kernels;
+    }
+    
+    // n + 1 - log2(log2 |z|) for a pixel that escaped after n iterations
+    // with the final |z|^2 norm
+    static float smoothIterations(int iterations, float norm) {
+        return iterations + 1 - std::log2(0.5f * std::log2(norm));
+    }
+    
+    // Escape data of a whole frame at WINDOW_WIDTH stride, as kept by the
+    // renderer, for the colorize checks of --benchmark and --verify
+    struct EscapeData {
+        std::vector<int> iterations;
+        std::vector<float> smooth;
+        std::vector<uint8_t> interior;
+    };
+    
+    static EscapeData escapeData(const std::vector<int>& iterations, const std::vector<float>& norms,
+                                 int maxIterations) {
+        EscapeData data{iterations, std::vector<float>(iterations.size()), std::vector<uint8_t>(iterations.size())};
+        for (size_t i = 0; i < iterations.size(); ++i) {
+            data.interior[i] = iterations[i] == maxIterations;
+            data.smooth[i] = data.interior[i] ? 0.0f : smoothIterations(iterations[i], norms[i]);
+        }
+        return data;
+    }
+    
+    static void colorizeEscapeData(ColorizeKernel kernel, const EscapeData& data, const PaletteIndex& index,
+                              std::vector<uint32_t>& colors) {
+        for (int y = 0; y < WINDOW_HEIGHT; ++y) {
+            const int offset = y * WINDOW_WIDTH;
+            kernel(&data.iterations[offset], &data.smooth[offset], &data.interior[offset], WINDOW_WIDTH, index,
+                   &colors[offset]);
+        }
+    }
+    
+    // Fills positions for escape times 0 to maxIterations. Equalized
+    // coloring spreads one cycle over the escaped pixels, equalization
+    // holding their cumulative share below each escape time.
+    static void fillPalettePositions(std::vector<uint32_t>& positions, int maxIterations, const Coloring& coloring,
+                                     const std::vector<float>& equalization) {
+        constexpr double scale = static_cast<double>(PALETTE_SIZE << PALETTE_FRACTION_BITS);
+        positions.resize(maxIterations + 1);
+        for (int n = 0; n <= maxIterations; ++n) {
+            double position;
+            if (coloring.equalize) {
+                position = equalization[n];
+            } else if (coloring.smooth) {
+                position = n / ITERATIONS_PER_PALETTE_CYCLE;
+            } else {
+                position = (n + 1 - std::log2(std::log2(std::max(n, 2)))) / ITERATIONS_PER_PALETTE_CYCLE;
+            }
+            const double fixed = std::floor((position * coloring.density + coloring.cycle) * scale);
+            positions[n] = static_cast<uint32_t>(static_cast<int64_t>(fixed));
+        }
+    }
+    
+    // Builds the palette positions for the current frame, equalizing over
+    // the escaped pixels on the sample grid of the given step
+    PaletteIndex buildPaletteIndex(int width, int height, int step, int maxIterations, const Coloring& coloring) {
+        if (coloring.equalize) {
+            histogram.assign(maxIterations + 1, 0);
+            for (int y = 0; y < height; y += step) {
+                for (int x = 0; x < width; x += step) {
+                    const int i = y * WINDOW_WIDTH + x;
+                    if (!interiorBuffer[i]) ++histogram[iterationBuffer[i]];
+                }
+            }
+            equalization.resize(maxIterations + 1);
+            const int total = std::max(1, std::accumulate(histogram.begin(), histogram.end(), 0));
+            int below = 0;
+            for (int n = 0; n <= maxIterations; ++n) {
+                equalization[n] = static_cast<float>(below) / total;
+                below += histogram[n];
+            }
+        }
+        fillPalettePositions(palettePositions, maxIterations, coloring, equalization);
+        return {palettePositions.data(), paletteTable(), maxIterations, coloring.smooth, coloring.interpolate};
+    }
+    
+    uint32_t pixelColor(int i, const PaletteIndex& index) const {
+        if (showPeriods && periodBuffer[i] != 0) return getPeriodColor(periodBuffer[i]);
+        uint32_t color;
+        colorizeRowScalar(&iterationBuffer[i], &smoothBuffer[i], &interiorBuffer[i], 1, index, &color);
+        return color;
+    }
+
+    // Closed-form membership test for the main cardioid (period 1) and the
+    // period-2 bulb. Their points never escape, so they would otherwise run
+    // for the full iteration limit. Returns the period, or 0 if outside both.
+    static int cardioidOrBulbPeriod(double x, double y) {
+        const double y2 = y * y;
+        const double xq = x - 0.25;
+        const double q = xq * xq + y2;
+        if (q * (q + xq) <= 0.25 * y2) return 1;
+        const double xb = x + 1.0;
+        return xb * xb + y2 <= 1.0 / 16.0 ? 2 : 0;
+    }
+
+    // The original std::complex escape loop, kept as the reference that
+    // --verify checks the kernels against
+    static int calculateMandelbrotReference(std::complex<double> c, int maxIterations) {
+        std::complex<double> z = 0;
+        int iterations = 0;
+        double zabs;
+        
+        while ((zabs = std::abs(z)) <= 2.0 && iterations < maxIterations) {
+            if (zabs > 2.0) break;
+            z = z * z + c;
+            iterations++;
+        }
+        
+        return iterations;
+    }
+
+    // Works on separate real/imaginary parts and compares |z|^2 against
+    // ESCAPE_RADIUS_SQUARED, reusing the squares for the next iteration
+    template <int Features = ALL_KERNEL_FEATURES>
+    static int calculateMandelbrot(double cr, double ci, int maxIterations, int& period, float& norm) {
+        period = 0;
+        norm = 0;
+        if constexpr ((Features & INTERIOR_CHECK) != 0) {
+            if ((period = cardioidOrBulbPeriod(cr, ci)) != 0) return maxIterations;
+        }
+        
+        double zr = 0, zi = 0;
+        double zr2 = 0, zi2 = 0;
+        int iterations = 0;
+        
+        // Brent's cycle detection: compare z against a saved orbit point
+        // that is refreshed after 1, 2, 4, 8, ... iterations
+        double savedR = 0, savedI = 0;
+        int sinceSaved = 0;
+        int saveInterval = 1;
+        
+        while (zr2 + zi2 <= ESCAPE_RADIUS_SQUARED && iterations < maxIterations) {
+            zi = (zr + zr) * zi + ci;
+            zr = zr2 - zi2 + cr;
+            zr2 = zr * zr;
+            zi2 = zi * zi;
+            iterations++;
+            
+            if constexpr ((Features & PERIODICITY_CHECK) != 0) {
+                sinceSaved++;
+                if (std::abs(zr - savedR) < PERIODICITY_EPSILON && std::abs(zi - savedI) < PERIODICITY_EPSILON) {
+                    period = sinceSaved;
+                    return maxIterations;
+                }
+                if (sinceSaved == saveInterval) {
+                    savedR = zr;
+                    savedI = zi;
+                    sinceSaved = 0;
+                    saveInterval *= 2;
+                }
+            }
+        }
+        
+        norm = static_cast<float>(zr2 + zi2);
+        return iterations;
+    }
+
+    template <int Features = ALL_KERNEL_FEATURES>
+    static void calculateRowScalar(const double* real, double imag, int count, int maxIterations,
+                                   int* iterations, int* periods, float* norms, const CancellationToken& cancel) {
+        for (int x = 0; x < count && !cancel.cancelled(); ++x) {
+            iterations[x] = calculateMandelbrot<Features>(real[x], imag, maxIterations, periods[x], norms[x]);
+        }
+    }
+
+#ifdef MANDELBROT_X86_SIMD
+    // 4 pixels per step. Escaped lanes are masked out of the counter, their z
+    // stays at the first point outside the radius, and the loop ends once
+    // every lane has escaped. Lanes in the cardioid or bulb
+    // start out finished at maxIterations, lanes caught in a cycle finish
+    // there when it is detected. All lanes share Brent's checkpoint schedule.
+    template <int Features = ALL_KERNEL_FEATURES>
+    __attribute__((target("avx2")))
+    static void calculateRowAvx2(const double* real, double imag, int count, int maxIterations,
+                                 int* iterations, int* periods, float* norms, const CancellationToken& cancel) {
+        const __m256d four = _mm256_set1_pd(ESCAPE_RADIUS_SQUARED);
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d limit = _mm256_set1_pd(maxIterations);
+        const __m256d epsilon = _mm256_set1_pd(PERIODICITY_EPSILON);
+        const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFF));
+        const __m256d ci = _mm256_set1_pd(imag);
+        const __m256d y2 = _mm256_set1_pd(imag * imag);
+        
+        int x = 0;
+        for (; x + 4 <= count; x += 4) {
+            if (cancel.cancelled()) return;
+            
+            const __m256d cr = _mm256_loadu_pd(real + x);
+            __m256d zr = _mm256_setzero_pd();
+            __m256d zi = _mm256_setzero_pd();
+            __m256d counts = _mm256_setzero_pd();
+            __m256d lanePeriods = _mm256_setzero_pd();
+            __m256d inside = _mm256_setzero_pd();
+            
+            if constexpr ((Features & INTERIOR_CHECK) != 0) {
+                __m256d xq = _mm256_sub_pd(cr, _mm256_set1_pd(0.25));
+                __m256d q = _mm256_add_pd(_mm256_mul_pd(xq, xq), y2);
+                __m256d cardioid = _mm256_cmp_pd(_mm256_mul_pd(q, _mm256_add_pd(q, xq)),
+                                                 _mm256_mul_pd(_mm256_set1_pd(0.25), y2), _CMP_LE_OQ);
+                __m256d xb = _mm256_add_pd(cr, one);
+                __m256d bulb = _mm256_andnot_pd(cardioid, _mm256_cmp_pd(_mm256_add_pd(_mm256_mul_pd(xb, xb), y2),
+                                                                        _mm256_set1_pd(1.0 / 16.0), _CMP_LE_OQ));
+                inside = _mm256_or_pd(cardioid, bulb);
+                counts = _mm256_and_pd(inside, limit);
+                lanePeriods = _mm256_or_pd(_mm256_and_pd(cardioid, one), _mm256_and_pd(bulb, _mm256_set1_pd(2.0)));
+            }
+            
+            __m256d savedR = zr;
+            __m256d savedI = zi;
+            int sinceSaved = 0;
+            int saveInterval = 1;
+            
+            for (int i = 0; i < maxIterations; ++i) {
+                __m256d zr2 = _mm256_mul_pd(zr, zr);
+                __m256d zi2 = _mm256_mul_pd(zi, zi);
+                __m256d active = _mm256_andnot_pd(inside, _mm256_cmp_pd(_mm256_add_pd(zr2, zi2), four, _CMP_LE_OQ));
+                if (_mm256_movemask_pd(active) == 0) break;
+                
+                counts = _mm256_add_pd(counts, _mm256_and_pd(active, one));
+                __m256d zrzi = _mm256_mul_pd(zr, zi);
+                zr = _mm256_blendv_pd(zr, _mm256_add_pd(_mm256_sub_pd(zr2, zi2), cr), active);
+                zi = _mm256_blendv_pd(zi, _mm256_add_pd(_mm256_add_pd(zrzi, zrzi), ci), active);
+                
+                if constexpr ((Features & PERIODICITY_CHECK) != 0) {
+                    sinceSaved++;
+                    __m256d closeR = _mm256_cmp_pd(_mm256_and_pd(_mm256_sub_pd(zr, savedR), absMask), epsilon, _CMP_LT_OQ);
+                    __m256d closeI = _mm256_cmp_pd(_mm256_and_pd(_mm256_sub_pd(zi, savedI), absMask), epsilon, _CMP_LT_OQ);
+                    __m256d cycled = _mm256_and_pd(active, _mm256_and_pd(closeR, closeI));
+                    if (_mm256_movemask_pd(cycled) != 0) {
+                        counts = _mm256_blendv_pd(counts, limit, cycled);
+                        lanePeriods = _mm256_blendv_pd(lanePeriods, _mm256_set1_pd(sinceSaved), cycled);
+                        inside = _mm256_or_pd(inside, cycled);
+                    }
+                    if (sinceSaved == saveInterval) {
+                        savedR = zr;
+                        savedI = zi;
+                        sinceSaved = 0;
+                        saveInterval *= 2;
+                    }
+                }
+            }
+            
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(iterations + x), _mm256_cvttpd_epi32(counts));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(periods + x), _mm256_cvttpd_epi32(lanePeriods));
+            const __m256d norm = _mm256_add_pd(_mm256_mul_pd(zr, zr), _mm256_mul_pd(zi, zi));
+            _mm_storeu_ps(norms + x, _mm256_cvtpd_ps(_mm256_andnot_pd(inside, norm)));
+        }
+        calculateRowScalar<Features>(real + x, imag, count - x, maxIterations, iterations + x, periods + x,
+                                     norms + x, cancel);
+    }
+
+    // 8 pixels per step using AVX-512 mask registers for the per-lane escape.
+    template <int Features = ALL_KERNEL_FEATURES>
+    __attribute__((target("avx512f")))
+    static void calculateRowAvx512(const double* real, double imag, int count, int maxIterations,
+                                   int* iterations, int* periods, float* norms, const CancellationToken& cancel) {
+        const __m512d four = _mm512_set1_pd(ESCAPE_RADIUS_SQUARED);
+        const __m512d one = _mm512_set1_pd(1.0);
+        const __m512d limit = _mm512_set1_pd(maxIterations);
+        const __m512d epsilon = _mm512_set1_pd(PERIODICITY_EPSILON);
+        const __m512d ci = _mm512_set1_pd(imag);
+        const __m512d y2 = _mm512_set1_pd(imag * imag);
+        
+        int x = 0;
+        for (; x + 8 <= count; x += 8) {
+            if (cancel.cancelled()) return;
+            
+            const __m512d cr = _mm512_loadu_pd(real + x);
+            __m512d zr = _mm512_setzero_pd();
+            __m512d zi = _mm512_setzero_pd();
+            __m512d counts = _mm512_setzero_pd();
+            __m512d lanePeriods = _mm512_setzero_pd();
+            __mmask8 inside = 0;
+            
+            if constexpr ((Features & INTERIOR_CHECK) != 0) {
+                __m512d xq = _mm512_sub_pd(cr, _mm512_set1_pd(0.25));
+                __m512d q = _mm512_add_pd(_mm512_mul_pd(xq, xq), y2);
+                __mmask8 cardioid = _mm512_cmp_pd_mask(_mm512_mul_pd(q, _mm512_add_pd(q, xq)),
+                                                       _mm512_mul_pd(_mm512_set1_pd(0.25), y2), _CMP_LE_OQ);
+                __m512d xb = _mm512_add_pd(cr, one);
+                __mmask8 bulb = _mm512_cmp_pd_mask(_mm512_add_pd(_mm512_mul_pd(xb, xb), y2),
+                                                   _mm512_set1_pd(1.0 / 16.0), _CMP_LE_OQ) & ~cardioid;
+                inside = cardioid | bulb;
+                counts = _mm512_mask_mov_pd(counts, inside, limit);
+                lanePeriods = _mm512_mask_mov_pd(lanePeriods, cardioid, one);
+                lanePeriods = _mm512_mask_mov_pd(lanePeriods, bulb, _mm512_set1_pd(2.0));
+            }
+            
+            __m512d savedR = zr;
+            __m512d savedI = zi;
+            int sinceSaved = 0;
+            int saveInterval = 1;
+            
+            for (int i = 0; i < maxIterations; ++i) {
+                __m512d zr2 = _mm512_mul_pd(zr, zr);
+                __m512d zi2 = _mm512_mul_pd(zi, zi);
+                __mmask8 active = _mm512_cmp_pd_mask(_mm512_add_pd(zr2, zi2), four, _CMP_LE_OQ) & ~inside;
+                if (active == 0) break;
+                
+                counts = _mm512_mask_add_pd(counts, active, counts, one);
+                __m512d zrzi = _mm512_mul_pd(zr, zi);
+                zr = _mm512_mask_add_pd(zr, active, _mm512_sub_pd(zr2, zi2), cr);
+                zi = _mm512_mask_add_pd(zi, active, _mm512_add_pd(zrzi, zrzi), ci);
+                
+                if constexpr ((Features & PERIODICITY_CHECK) != 0) {
+                    sinceSaved++;
+                    __mmask8 cycled = active &
+                        _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(zr, savedR)), epsilon, _CMP_LT_OQ) &
+                        _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(zi, savedI)), epsilon, _CMP_LT_OQ);
+                    if (cycled != 0) {
+                        counts = _mm512_mask_mov_pd(counts, cycled, limit);
+                        lanePeriods = _mm512_mask_mov_pd(lanePeriods, cycled, _mm512_set1_pd(sinceSaved));
+                        inside |= cycled;
+                    }
+                    if (sinceSaved == saveInterval) {
+                        savedR = zr;
+                        savedI = zi;
+                        sinceSaved = 0;
+                        saveInterval *= 2;
+                    }
+                }
+            }
+            
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(iterations + x), _mm512_maskz_cvttpd_epi32(0xFF, counts));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(periods + x), _mm512_maskz_cvttpd_epi32(0xFF, lanePeriods));
+            const __m512d norm = _mm512_add_pd(_mm512_mul_pd(zr, zr), _mm512_mul_pd(zi, zi));
+            _mm256_storeu_ps(norms + x, _mm512_maskz_cvtpd_ps(static_cast<__mmask8>(~inside), norm));
+        }
+        // Only AVX-512F was checked for this kernel, so the tail is scalar
+        calculateRowScalar<Features>(real + x, imag, count - x, maxIterations, iterations + x, periods + x,
+                                     norms + x, cancel);
+    }
+#endif
+
+    struct KernelVariant {
+        const char* name;
+        // Indexed by KernelFeature bits
+        RowKernel kernels[ALL_KERNEL_FEATURES + 1];
+    };
+
+    // Kernels the host can run, widest instruction set first
+    static std::vector<KernelVariant> supportedRowKernels() {
+        std::vector<KernelVariant> kernels;
+#ifdef MANDELBROT_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            kernels.push_back({"AVX-512", {calculateRowAvx512<0>, calculateRowAvx512<1>,
+                                           calculateRowAvx512<2>, calculateRowAvx512<3>}});
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            kernels.push_back({"AVX2", {calculateRowAvx2<0>, calculateRowAvx2<1>,
+                                        calculateRowAvx2<2>, calculateRowAvx2<3>}});
+        }
+#endif
+        kernels.push_back({"scalar", {calculateRowScalar<0>, calculateRowScalar<1>,
+                                      calculateRowScalar<2>, calculateRowScalar<3>}});
+        return kernels;
+    }
+
+    // Fraction limbs of the view center at the given zoom
+    static int precisionForZoom(const FloatExp& zoom) {
+        return (static_cast<int>(std::max(zoom.log2(), 0.0)) + PRECISION_GUARD_BITS + 31) / 32;
+    }
+    
+    // Iterates (cx, cy) at their precision. Returns false if cancelled.
+    static bool computeReferenceOrbit(ReferenceOrbit& orbit, const FixedPoint& cx, const FixedPoint& cy,
+                                      int maxIterations, const CancellationToken& cancel) {
+        orbit.centerX = cx;
+        orbit.centerY = cy;
+        orbit.maxIterations = maxIterations;
+        orbit.escaped = false;
+        orbit.real.assign(1, 0.0);
+        orbit.imag.assign(1, 0.0);
+        
+        const int precision = std::max(cx.precision(), cy.precision());
+        FixedPoint zr(0.0, precision), zi(0.0, precision);
+        FixedPoint zr2(0.0, precision), zi2(0.0, precision), zri(0.0, precision);
+        for (int n = 0; n < maxIterations; ++n) {
+            if (n % 1024 == 0 && cancel.cancelled()) return false;
+            
+            FixedPoint::multiply(zr, zi, zri);
+            zi = zri;
+            zi += zri;
+            zi += cy;
+            zr = zr2;
+            zr -= zi2;
+            zr += cx;
+            FixedPoint::multiply(zr, zr, zr2);
+            FixedPoint::multiply(zi, zi, zi2);
+            
+            const double r = zr.toDouble(), i = zi.toDouble();
+            orbit.real.push_back(r);
+            orbit.imag.push_back(i);
+            if (r * r + i * i > ESCAPE_RADIUS_SQUARED) {
+                orbit.escaped = true;
+                break;
+            }
+        }
+        return true;
+    }
+    
+    // The delta at the skip in units of series.scale
+    static std::complex<double> evaluateSeries(const SeriesApproximation& series, std::complex<double> pixel) {
+        const std::complex<double> w = pixel / series.radius;
+        std::complex<double> d = 0;
+        for (int k = SERIES_TERMS - 1; k >= 0; --k) {
+            d = (d + series.coefficients[k]) * w;
+        }
+        return d;
+    }
+    
+    // Finds the series for pixels up to corners, the view's corners, from
+    // the reference point, spacing apart. Its coefficients follow
+    // d' = 2Zd + d^2 + dc term by term, alongside the exact deltas of the
+    // corner pixels, both in units of the scale; the skip ends before the
+    // first iteration at which the series misses a corner by more than
+    // SERIES_TOLERANCE, or a corner escapes or glitches. Returns false if
+    // cancelled.
+    static bool computeSeriesApproximation(SeriesApproximation& series, const ReferenceOrbit& orbit,
+                                           const std::array<std::complex<double>, 4>& corners,
+                                           const FloatExp& spacing, int maxIterations,
+                                           const CancellationToken& cancel) {
+        using Complex = std::complex<double>;
+        series = {};
+        double radius = 0;
+        for (const Complex& corner : corners) radius = std::max(radius, std::abs(corner));
+        if (radius == 0) return true;
+        series.radius = radius;
+        series.scale = radius * spacing;
+        
+        // Pixels resume at the skip and advance the orbit from there, so it
+        // must leave them at least one step before the orbit ends
+        const int limit = std::min(orbit.length() - 1, maxIterations) - 1;
+        std::array<Complex, SERIES_TERMS> next;
+        std::array<Complex, 4> deltas{};
+        for (int n = 0; n < limit; ++n) {
+            if (n % 1024 == 0 && cancel.cancelled()) return false;
+            
+            // Products of two terms carry one more factor of the scale; terms
+            // that underflow here are negligible against the first one
+            const double scale = series.scale.toDouble();
+            const double pixelStep = (spacing / series.scale).toDouble();
+            const Complex twoZ = 2.0 * Complex(orbit.real[n], orbit.imag[n]);
+            for (int k = 0; k < SERIES_TERMS; ++k) {
+                Complex products = 0;
+                for (int i = 0; i < k; ++i) {
+                    products += series.coefficients[i] * series.coefficients[k - 1 - i];
+                }
+                next[k] = twoZ * series.coefficients[k] + scale * products;
+            }
+            next[0] += radius * pixelStep;
+            
+            if (std::abs(next[SERIES_TERMS - 1]) > SERIES_TOLERANCE * std::abs(next[0])) return true;
+            
+            const Complex z(orbit.real[n + 1], orbit.imag[n + 1]);
+            SeriesApproximation candidate{n + 1, radius, series.scale, next};
+            std::array<Complex, 4> candidateDeltas;
+            for (int i = 0; i < 4; ++i) {
+                Complex& d = candidateDeltas[i];
+                d = (twoZ + scale * deltas[i]) * deltas[i] + corners[i] * pixelStep;
+                const double norm = std::norm(z + scale * d);
+                if (norm > ESCAPE_RADIUS_SQUARED || norm < GLITCH_TOLERANCE_SQUARED * std::norm(z) ||
+                    std::abs(evaluateSeries(candidate, corners[i]) - d) > SERIES_TOLERANCE * std::abs(d)) {
+                    return true;
+                }
+            }
+            
+            // Moves powers of two between the scale and the coefficients to
+            // keep the first one near 1
+            const int shift = std::ilogb(std::abs(next[0]));
+            if (next[0] != 0.0 && std::abs(shift) > 64) {
+                const double factor = std::ldexp(1.0, -shift);
+                for (Complex& coefficient : candidate.coefficients) coefficient *= factor;
+                for (Complex& d : candidateDeltas) d *= factor;
+                candidate.scale *= FloatExp(1.0, shift);
+            }
+            series = candidate;
+            deltas = candidateDeltas;
+        }
+        return true;
+    }
+    
+    // Merges pairs of runs level by level, starting from the single steps
+    // d -> 2 Z_m d + dc. Returns false if cancelled.
+    static bool buildBilinearTable(BilinearTable& table, const ReferenceOrbit& orbit, const FloatExp& dcRadius,
+                                   const CancellationToken& cancel) {
+        using Complex = std::complex<double>;
+        table.dcRadius = dcRadius;
+        table.levels.clear();
+        
+        const int last = orbit.length() - 1;
+        std::vector<BilinearStep> steps(std::max(0, last - 1));
+        for (int m = 1; m < last; ++m) {
+            const Complex a = 2.0 * Complex(orbit.real[m], orbit.imag[m]);
+            steps[m - 1] = {a, 1.0, BILINEAR_TOLERANCE * std::abs(a)};
+        }
+        
+        const std::vector<BilinearStep>* previous = &steps;
+        while (previous->size() >= 2) {
+            if (cancel.cancelled()) return false;
+            
+            // The second run starts at a d grown by the first, |d| < |a_x| r + |b_x| dcRadius
+            std::vector<BilinearStep> merged(previous->size() / 2);
+            for (size_t j = 0; j < merged.size(); ++j) {
+                const BilinearStep& x = (*previous)[2 * j];
+                const BilinearStep& y = (*previous)[2 * j + 1];
+                const double growth = (std::abs(x.b) * dcRadius).toDouble();
+                const double radius = std::max(0.0, (y.radius - growth) / std::abs(x.a));
+                merged[j] = {y.a * x.a, y.a * x.b + y.b, std::min(x.radius, radius)};
+            }
+            table.levels.push_back(std::move(merged));
+            previous = &table.levels.back();
+        }
+        return true;
+    }
     
-    SDL_Window* window;
-    SDL_Renderer* renderer;
-    SDL_Texture* texture;
-    std::vector<uint32_t> pixels;
-    std::vector<uint32_t> tempPixels;
+    static double toDouble(double value) { return value; }
+    static double toDouble(const FloatExp& value) { return value.toDouble(); }
     
-    // View parameters
-    double centerX = -0.5;
-    double centerY = 0.0;
-    double zoom = 1.0;
+    // Iterates one perturbed pixel from n, m and d until it escapes or
+    // reaches maxIterations. FloatExp deltas stop early once either
+    // component reaches 2^DOUBLE_DELTA_EXPONENT, for the caller to continue
+    // in double.
+    template <typename Delta>
+    static void iteratePerturbed(const ReferenceOrbit& orbit, const BilinearTable& table, Delta cr, Delta ci,
+                                 int maxIterations, Delta& dr, Delta& di, int& n, int& m, double& norm,
+                                 bool& glitched) {
+        const double* orbitReal = orbit.real.data();
+        const double* orbitImag = orbit.imag.data();
+        const int last = orbit.length() - 1;
+        const int levelCount = static_cast<int>(table.levels.size());
+        
+        while (norm <= ESCAPE_RADIUS_SQUARED && n < maxIterations) {
+            if constexpr (std::is_same_v<Delta, FloatExp>) {
+                if (std::max(dr.ilogb(), di.ilogb()) >= DOUBLE_DELTA_EXPONENT) return;
+            }
+            
+            // Radii shrink with the level, so the first run d is too large
+            // for ends the search
+            const BilinearStep* jump = nullptr;
+            int jumpLength = 0;
+            const Delta deltaNorm = m > 0 && levelCount > 0 ? dr * dr + di * di : Delta();
+            for (int level = 0; m > 0 && level < levelCount; ++level) {
+                const int length = 2 << level;
+                const size_t j = (m - 1) / length;
+                if (((m - 1) & (length - 1)) != 0 || j >= table.levels[level].size() ||
+                    n + length > maxIterations) {
+                    break;
+                }
+                const BilinearStep& step = table.levels[level][j];
+                if (deltaNorm >= step.radius * step.radius) break;
+                jump = &step;
+                jumpLength = length;
+            }
+            
+            if (jump) {
+                const double ar = jump->a.real(), ai = jump->a.imag();
+                const double br = jump->b.real(), bi = jump->b.imag();
+                const Delta nr = ar * dr - ai * di + br * cr - bi * ci;
+                di = ar * di + ai * dr + br * ci + bi * cr;
+                dr = nr;
+                n += jumpLength;
+                m += jumpLength;
+            } else {
+                const Delta tr = dr + 2 * orbitReal[m], ti = di + 2 * orbitImag[m];
+                const Delta nr = tr * dr - ti * di + cr;
+                di = tr * di + ti * dr + ci;
+                dr = nr;
+                n++;
+                m++;
+            }
+            
+            const Delta zr = dr + orbitReal[m], zi = di + orbitImag[m];
+            const double zrValue = toDouble(zr), ziValue = toDouble(zi);
+            norm = zrValue * zrValue + ziValue * ziValue;
+            const double referenceNorm = orbitReal[m] * orbitReal[m] + orbitImag[m] * orbitImag[m];
+            const bool glitch = norm < GLITCH_TOLERANCE_SQUARED * referenceNorm;
+            if (glitch || m == last) {
+                glitched = glitched || glitch;
+                dr = zr;
+                di = zi;
+                m = 0;
+            }
+        }
+    }
     
-    SDL_Point dragStart{};
-    bool isDragging = false;
-
-    uint32_t getColor(int iterations) const {
-        if (iterations == MAX_ITERATIONS) return 0;
+    // Escape times by perturbation: each pixel iterates its difference d to
+    // the reference orbit, d' = (2Z + d) d + dc, where dc is the pixel's
+    // offset from the reference point. The offsets are passed in pixels,
+    // spacing apart, and the deltas are Delta: double, or FloatExp for
+    // zooms whose deltas would underflow it. Periods are not detected.
+    //
+    // Once z = Z + d is much smaller than Z (Pauldelbrot's criterion), d has
+    // cancelled most of Z and lost its precision relative to z: the pixel
+    // glitches. It is rebased onto the start of the reference orbit, where
+    // Z_0 = 0 and so d = z exactly, and continues against the orbit from
+    // there. Pixels outliving an escaped reference orbit are rebased the
+    // same way. Every pixel starts at the series' skip, with d taken from
+    // the series, and jumps ahead by the longest run of the bilinear table
+    // it is small enough for. A run's radius keeps d far below Z, so pixels
+    // neither glitch nor escape within it. Returns the number of pixels
+    // that glitched.
+    template <typename Delta>
+    static int calculateRowPerturbed(const ReferenceOrbit& orbit, const SeriesApproximation& series,
+                                     const BilinearTable& table, const FloatExp& spacing, const double* pixelReal,
+                                     double pixelImag, int count, int maxIterations, int* iterations, int* periods,
+                                     float* norms, const CancellationToken& cancel) {
+        Delta step, seriesScale;
+        if constexpr (std::is_same_v<Delta, double>) {
+            step = spacing.toDouble();
+            seriesScale = series.scale.toDouble();
+        } else {
+            step = spacing;
+            seriesScale = series.scale;
+        }
+        int glitches = 0;
         
-        // Smooth coloring
-        double smooth = iterations + 1 - std::log2(std::log2(std::abs(iterations)));
-        double hue = std::fmod(smooth / 32.0, 1.0);
+        for (int x = 0; x < count && !cancel.cancelled(); ++x) {
+            const Delta cr = pixelReal[x] * step, ci = pixelImag * step;
+            const std::complex<double> d = evaluateSeries(series, {pixelReal[x], pixelImag});
+            Delta dr = d.real() * seriesScale, di = d.imag() * seriesScale;
+            double norm = 0;
+            int n = series.skip;
+            // Position in the reference orbit, behind n after a rebase
+            int m = series.skip;
+            bool glitched = false;
+            iteratePerturbed(orbit, table, cr, ci, maxIterations, dr, di, n, m, norm, glitched);
+            if constexpr (!std::is_same_v<Delta, double>) {
+                double doubleReal = dr.toDouble(), doubleImag = di.toDouble();
+                iteratePerturbed(orbit, table, cr.toDouble(), ci.toDouble(), maxIterations, doubleReal, doubleImag,
+                                 n, m, norm, glitched);
+            }
+            iterations[x] = n;
+            periods[x] = 0;
+            norms[x] = static_cast<float>(norm);
+            glitches += glitched;
+        }
+        return glitches;
+    }
+    
+    // Moves a per-pixel buffer so that pixel (x, y) holds what was at
+    // (x + dx, y + dy). Pixels shifted in from outside are left stale.
+    template <typename T>
+    static void shiftBuffer(std::vector<T>& buffer, int dx, int dy) {
+        const int width = WINDOW_WIDTH - std::abs(dx);
+        auto moveRow = [&](int y) {
+            std::memmove(&buffer[y * WINDOW_WIDTH + std::max(0, -dx)],
+                         &buffer[(y + dy) * WINDOW_WIDTH + std::max(0, dx)],
+                         width * sizeof(T));
+        };
         
-        // Better color distribution
-        double r = std::abs(std::sin(2 * M_PI * (hue + 0.0/3.0)));
-        double g = std::abs(std::sin(2 * M_PI * (hue + 1.0/3.0)));
-        double b = std::abs(std::sin(2 * M_PI * (hue + 2.0/3.0)));
+        if (dy >= 0) {
+            for (int y = 0; y < WINDOW_HEIGHT - dy; ++y) moveRow(y);
+        } else {
+            for (int y = WINDOW_HEIGHT - 1; y >= -dy; --y) moveRow(y);
+        }
+    }
+
+    // Takes the back target to draw into. With wait, blocks until the UI
+    // thread has shown the previous frame; otherwise fails if it has not.
+    bool acquireFrame(FrameTarget& frame, bool wait) {
+        std::unique_lock lock(frameMutex);
+        if (wait) {
+            frameCondition.wait(lock, [&] { return stopping || !frameReady; });
+        }
+        if (stopping || frameReady) return false;
+        frame = backTarget;
+        frameInProgress = true;
+        return true;
+    }
+
+    // Hands the back target back to the UI thread, as a frame to show if
+    // ready; final is false for the coarse passes of a progressive frame
+    void releaseFrame(bool ready, int divisor, bool final) {
+        {
+            std::lock_guard lock(frameMutex);
+            frameInProgress = false;
+            frameReady = ready;
+            readyDivisor = divisor;
+        }
+        if (ready && window) {
+            SDL_Event event{};
+            event.type = frameReadyEvent;
+            event.user.code = final;
+            SDL_PushEvent(&event);
+        }
+    }
+
+    // Picks the resolution of an interactive frame: the smallest divisor at
+    // which the estimated frame time fits FRAME_BUDGET_MS. Frame time scales
+    // with the pixel count; stepping back towards full resolution needs some
+    // headroom so the divisor does not flip between two values.
+    int chooseResolutionDivisor(bool interactive) {
+        if (!interactive) return 1;
         
-        return static_cast<uint32_t>(r * 255) << 16 |
-               static_cast<uint32_t>(g * 255) << 8 |
-               static_cast<uint32_t>(b * 255);
+        auto estimatedMs = [&](int divisor) { return fullFrameMs / (divisor * divisor); };
+        int divisor = resolutionDivisor;
+        while (divisor < MAX_RESOLUTION_DIVISOR && estimatedMs(divisor) > FRAME_BUDGET_MS) divisor++;
+        while (divisor > 1 && estimatedMs(divisor - 1) < 0.7 * FRAME_BUDGET_MS) divisor--;
+        resolutionDivisor = divisor;
+        return divisor;
     }
 
-    int calculateMandelbrot(std::complex<double> c) const {
-        std::complex<double> z = 0;
-        int iterations = 0;
-        double zabs;
+    static int iterationsForZoom(const FloatExp& zoom) {
+        return MIN_ITERATIONS + static_cast<int>(ITERATIONS_PER_OCTAVE * std::max(0.0, zoom.log2()));
+    }
+
+    // Picks the iteration limit from the zoom depth and from the last
+    // finished frame: many slow escapes mean detail is being cut off at the
+    // limit, a slowest escape far below it means iterations are wasted on
+    // the interior.
+    int chooseIterationLimit(const View& view, int pixelCount) {
+        if (const int manual = iterationOverride; manual > 0) return manual;
         
-        while ((zabs = std::abs(z)) <= 2.0 && iterations < MAX_ITERATIONS) {
-            if (zabs > 2.0) break;
-            z = z * z + c;
-            iterations++;
+        const int fromZoom = iterationsForZoom(view.zoom);
+        int limit = finishedIterations;
+        if (slowEscapes > SLOW_ESCAPE_FRACTION * pixelCount) {
+            limit *= 2;
+        } else if (slowestEscape < limit / 4) {
+            limit /= 2;
         }
-        
-        return iterations;
+        return std::clamp(std::max(limit, fromZoom), MIN_ITERATIONS, MAX_ITERATION_LIMIT);
     }
 
-    void renderMandelbrot() {
-        const int numThreads = std::thread::hardware_concurrency();
-        std::vector<std::thread> threads;
-        std::vector<std::vector<uint32_t>> threadBuffers(numThreads, std::vector<uint32_t>(WINDOW_WIDTH * WINDOW_HEIGHT));
+    // Renders view on the pool and hands the frame to the UI thread. Returns
+    // false if a newer request cancelled the frame before it was finished.
+    bool renderMandelbrot(const View& view, bool interactive, const CancellationToken& cancel) {
+        // Buffers keep their WINDOW_WIDTH stride at reduced resolution; only
+        // the top-left width x height pixels are used
+        const int divisor = chooseResolutionDivisor(interactive);
+        const int width = WINDOW_WIDTH / divisor;
+        const int height = WINDOW_HEIGHT / divisor;
+        const int maxIterations = chooseIterationLimit(view, width * height);
+        using Clock = std::chrono::steady_clock;
+        const auto frameStart = Clock::now();
+        FrameStats stats;
+        stats.resolutionDivisor = divisor;
         
-        auto renderLine = [this](std::vector<uint32_t>& buffer, int startY, int endY) {
-            for (int y = startY; y < endY; ++y) {
-                for (int x = 0; x < WINDOW_WIDTH; ++x) {
-                    double real = (x - WINDOW_WIDTH/2.0) / (zoom * WINDOW_WIDTH/4.0) + centerX;
-                    double imag = (y - WINDOW_HEIGHT/2.0) / (zoom * WINDOW_WIDTH/4.0) + centerY;
-                    
-                    std::complex<double> c(real, imag);
-                    int iterations = calculateMandelbrot(c);
-                    buffer[y * WINDOW_WIDTH + x] = getColor(iterations);
+        // A pan by whole pixels keeps the still valid part of the iteration
+        // buffer; only pixels outside validRegion are computed, the rest are
+        // just recolored. Switching fill mode recomputes everything so its
+        // timing shows up in the stats; a new iteration limit invalidates
+        // the interior pixels. Filled pixels copy the final |z| of another
+        // pixel, so smooth coloring renders by brute force.
+        const FillMode mode = smoothColoring ? BRUTE_FORCE : fillMode.load();
+        // Pixels per unit, which only fits a double below the perturbation zoom
+        const FloatExp scale = view.zoom * (width/4.0);
+        const double shiftX = ((view.centerX - renderedView.centerX).toFloatExp() * scale).toDouble();
+        const double shiftY = ((view.centerY - renderedView.centerY).toFloatExp() * scale).toDouble();
+        if (view.zoom == renderedView.zoom && mode == renderedFillMode && divisor == renderedDivisor &&
+            maxIterations == renderedIterations &&
+            std::abs(shiftX) < width && std::abs(shiftY) < height &&
+            std::abs(shiftX - std::round(shiftX)) < 1e-3 && std::abs(shiftY - std::round(shiftY)) < 1e-3) {
+            const int dx = static_cast<int>(std::round(shiftX));
+            const int dy = static_cast<int>(std::round(shiftY));
+            shiftBuffer(iterationBuffer, dx, dy);
+            shiftBuffer(periodBuffer, dx, dy);
+            shiftBuffer(normBuffer, dx, dy);
+            shiftBuffer(smoothBuffer, dx, dy);
+            shiftBuffer(interiorBuffer, dx, dy);
+            
+            validRegion = {std::max(validRegion.x0 - dx, 0), std::max(validRegion.y0 - dy, 0),
+                           std::min(validRegion.x1 - dx, width), std::min(validRegion.y1 - dy, height)};
+            if (validRegion.x0 >= validRegion.x1 || validRegion.y0 >= validRegion.y1) {
+                validRegion = {};
+            }
+        } else {
+            validRegion = {};
+        }
+        renderedView = view;
+        renderedFillMode = mode;
+        renderedDivisor = divisor;
+        renderedIterations = maxIterations;
+        const bool fullRecompute = validRegion.x0 == validRegion.x1;
+        
+        // Deep views are rendered relative to a reference orbit. It is kept
+        // while its point stays within a view of the center and it is precise
+        // and long enough, so panning and zooming around it reuse it.
+        const bool perturbed = view.zoom >= PERTURBATION_ZOOM;
+        const bool extendedRange = view.zoom >= EXTENDED_RANGE_ZOOM;
+        const FloatExp spacing = 1.0 / scale;
+        double referenceX = view.centerX.toDouble(), referenceY = view.centerY.toDouble();
+        if (perturbed) {
+            const int precision = precisionForZoom(view.zoom);
+            // In pixels
+            double offsetX = ((view.centerX - referenceOrbit.centerX).toFloatExp() * scale).toDouble();
+            double offsetY = ((view.centerY - referenceOrbit.centerY).toFloatExp() * scale).toDouble();
+            const bool usable = referenceOrbit.length() > 0 && referenceOrbit.centerX.precision() >= precision &&
+                                (referenceOrbit.escaped || referenceOrbit.maxIterations >= maxIterations) &&
+                                std::abs(offsetX) < width && std::abs(offsetY) < height;
+            if (!usable) {
+                FixedPoint cx = view.centerX, cy = view.centerY;
+                cx.setPrecision(precision);
+                cy.setPrecision(precision);
+                const auto referenceStart = Clock::now();
+                bilinearTable = {};
+                if (!computeReferenceOrbit(referenceOrbit, cx, cy, maxIterations, cancel)) {
+                    referenceOrbit = {};
+                    return false;
+                }
+                stats.referenceMs = std::chrono::duration<double, std::milli>(Clock::now() - referenceStart).count();
+                offsetX = offsetY = 0;
+            }
+            referenceX = offsetX;
+            referenceY = offsetY;
+            stats.referenceIterations = referenceOrbit.length() - 1;
+        }
+        
+        // Every row shares the same real coordinates. Perturbed rows hold the
+        // offsets from the reference point in pixels instead, which fit a
+        // double at any zoom.
+        const double pixelScale = perturbed ? 1.0 : scale.toDouble();
+        std::vector<double> rowReal(width);
+        for (int x = 0; x < width; ++x) {
+            rowReal[x] = (x - width/2.0) / pixelScale + referenceX;
+        }
+        auto imagAt = [&](int y) { return (y - height/2.0) / pixelScale + referenceY; };
+        
+        // The series depends on the extent of the view around the reference
+        // point, so it is found again every frame. The bilinear table is
+        // built for the farthest pixel of any view that keeps the reference
+        // at this zoom, and only rebuilt for a new reference or further out.
+        SeriesApproximation series;
+        if (perturbed) {
+            const auto seriesStart = Clock::now();
+            const std::array<std::complex<double>, 4> corners{{{rowReal[0], imagAt(0)},
+                                                               {rowReal[width - 1], imagAt(0)},
+                                                               {rowReal[0], imagAt(height - 1)},
+                                                               {rowReal[width - 1], imagAt(height - 1)}}};
+            if (!computeSeriesApproximation(series, referenceOrbit, corners, spacing, maxIterations, cancel)) {
+                return false;
+            }
+            stats.seriesMs = std::chrono::duration<double, std::milli>(Clock::now() - seriesStart).count();
+            stats.seriesSkip = series.skip;
+            
+            if (bilinearTable.dcRadius < series.radius * spacing) {
+                const auto bilinearStart = Clock::now();
+                if (!buildBilinearTable(bilinearTable, referenceOrbit, std::hypot(1.5 * width, 1.5 * height) * spacing,
+                                        cancel)) {
+                    bilinearTable = {};
+                    return false;
                 }
+                stats.bilinearMs = std::chrono::duration<double, std::milli>(Clock::now() - bilinearStart).count();
+            }
+            stats.bilinearLevels = static_cast<int>(bilinearTable.levels.size());
+            stats.extendedRange = extendedRange;
+        }
+        
+        auto computeRow = [&](const double* real, double imag, int count, int* iterations, int* periods,
+                              float* norms, WorkerStats& stats) {
+            if (extendedRange) {
+                stats.glitches += calculateRowPerturbed<FloatExp>(referenceOrbit, series, bilinearTable, spacing, real,
+                                                                  imag, count, maxIterations, iterations, periods,
+                                                                  norms, cancel);
+            } else if (perturbed) {
+                stats.glitches += calculateRowPerturbed<double>(referenceOrbit, series, bilinearTable, spacing, real,
+                                                                imag, count, maxIterations, iterations, periods,
+                                                                norms, cancel);
+            } else {
+                rowKernel(real, imag, count, maxIterations, iterations, periods, norms, cancel);
             }
         };
         
-        // Split work among threads with separate buffers
-        int linesPerThread = WINDOW_HEIGHT / numThreads;
-        for (int i = 0; i < numThreads; ++i) {
-            int startY = i * linesPerThread;
-            int endY = (i == numThreads - 1) ? WINDOW_HEIGHT : (i + 1) * linesPerThread;
-            threads.emplace_back(renderLine, std::ref(threadBuffers[i]), startY, endY);
+        FrameTarget frame{};
+        const Coloring coloring{smoothColoring, histogramEqualization, paletteInterpolation, paletteDensity,
+                                colorCycle};
+        
+        // Derives the interior flag and the smooth iteration count from the
+        // kernel outputs
+        auto finishPixel = [&](int i) {
+            interiorBuffer[i] = iterationBuffer[i] == maxIterations;
+            smoothBuffer[i] = interiorBuffer[i] ? 0.0f : smoothIterations(iterationBuffer[i], normBuffer[i]);
+        };
+        auto copyPixel = [&](int to, int from) {
+            iterationBuffer[to] = iterationBuffer[from];
+            periodBuffer[to] = periodBuffer[from];
+            normBuffer[to] = normBuffer[from];
+            smoothBuffer[to] = smoothBuffer[from];
+            interiorBuffer[to] = interiorBuffer[from];
+        };
+        
+        auto computeSpan = [&](int y, int x0, int x1, WorkerStats& stats) {
+            if (x0 >= x1) return;
+            const int offset = y * WINDOW_WIDTH + x0;
+            computeRow(rowReal.data() + x0, imagAt(y), x1 - x0,
+                       &iterationBuffer[offset], &periodBuffer[offset], &normBuffer[offset], stats);
+            for (int i = offset; i < offset + x1 - x0; ++i) finishPixel(i);
+            stats.pixels += x1 - x0;
+        };
+        auto computeColumn = [&](int x, int y0, int y1, WorkerStats& stats) {
+            for (int y = y0; y < y1; ++y) {
+                computeSpan(y, x, x + 1, stats);
+            }
+        };
+        
+        // Progressive passes compute the samples on a grid of the given step
+        // that coarser passes have not, and show each sample as a block
+        auto computeSamples = [&](const Tile& tile, int step, WorkerStats& stats) {
+            for (int y = tile.y0; y < tile.y1 && !cancel.cancelled(); y += step) {
+                // Rows of the coarser grid already have every other sample
+                const bool coarseRow = step != PROGRESSIVE_STEPS[0] && y % (2 * step) == 0;
+                const int first = coarseRow ? tile.x0 + step : tile.x0;
+                const int stride = coarseRow ? 2 * step : step;
+                if (stride == 1) {
+                    computeSpan(y, first, tile.x1, stats);
+                    continue;
+                }
+                
+                double real[TILE_SIZE];
+                int iterations[TILE_SIZE];
+                int periods[TILE_SIZE];
+                float norms[TILE_SIZE];
+                int count = 0;
+                for (int x = first; x < tile.x1; x += stride) {
+                    real[count++] = rowReal[x];
+                }
+                computeRow(real, imagAt(y), count, iterations, periods, norms, stats);
+                for (int i = 0; i < count; ++i) {
+                    const int index = y * WINDOW_WIDTH + first + i * stride;
+                    iterationBuffer[index] = iterations[i];
+                    periodBuffer[index] = periods[i];
+                    normBuffer[index] = norms[i];
+                    finishPixel(index);
+                }
+                stats.pixels += count;
+            }
+        };
+        
+        // Tiles are disjoint, so workers write straight into the shared buffers
+        auto renderTile = [&](const Tile& tile, WorkerStats& stats) {
+            for (int y = tile.y0; y < tile.y1 && !cancel.cancelled(); ++y) {
+                if (y < validRegion.y0 || y >= validRegion.y1) {
+                    computeSpan(y, tile.x0, tile.x1, stats);
+                } else {
+                    computeSpan(y, tile.x0, std::min(tile.x1, validRegion.x0), stats);
+                    computeSpan(y, std::max(tile.x0, validRegion.x1), tile.x1, stats);
+                }
+            }
+        };
+        
+        // Subdivided rectangles share their edges with their siblings. Every
+        // pixel is still computed or filled exactly once: the edges by
+        // whoever computed them, the inside when it is filled. Filled pixels
+        // copy the first border pixel.
+        auto subdivideTile = [&](const Tile& tile, int worker, WorkerStats& stats) {
+            const int x0 = tile.x0, y0 = tile.y0, x1 = tile.x1, y1 = tile.y1;
+            if (!tile.borderComputed) {
+                computeSpan(y0, x0, x1, stats);
+                if (y1 - y0 > 1) {
+                    computeSpan(y1 - 1, x0, x1, stats);
+                }
+                for (int x : {x0, x1 - 1}) {
+                    computeColumn(x, y0 + 1, y1 - 1, stats);
+                    if (x1 - x0 == 1) break;
+                }
+            }
+            if (x1 - x0 <= 2 || y1 - y0 <= 2 || cancel.cancelled()) return;
+            
+            const int first = y0 * WINDOW_WIDTH + x0;
+            auto matchesFirst = [&](int x, int y) {
+                const int i = y * WINDOW_WIDTH + x;
+                return iterationBuffer[i] == iterationBuffer[first] && periodBuffer[i] == periodBuffer[first];
+            };
+            bool uniform = true;
+            for (int x = x0; x < x1 && uniform; ++x) {
+                uniform = matchesFirst(x, y0) && matchesFirst(x, y1 - 1);
+            }
+            for (int y = y0; y < y1 && uniform; ++y) {
+                uniform = matchesFirst(x0, y) && matchesFirst(x1 - 1, y);
+            }
+            
+            if (uniform) {
+                for (int y = y0 + 1; y < y1 - 1; ++y) {
+                    for (int x = x0 + 1; x < x1 - 1; ++x) copyPixel(y * WINDOW_WIDTH + x, first);
+                }
+            } else if (x1 - x0 <= MIN_SUBDIVISION_SIZE || y1 - y0 <= MIN_SUBDIVISION_SIZE) {
+                for (int y = y0 + 1; y < y1 - 1; ++y) {
+                    computeSpan(y, x0 + 1, x1 - 1, stats);
+                }
+            } else {
+                // Compute the cross through the middle, then queue the four
+                // quadrants, which other workers may steal
+                const int mx = (x0 + x1) / 2;
+                const int my = (y0 + y1) / 2;
+                computeSpan(my, x0 + 1, x1 - 1, stats);
+                for (int y = y0 + 1; y < y1 - 1; ++y) {
+                    if (y == my) continue;
+                    computeSpan(y, mx, mx + 1, stats);
+                }
+                scheduler.push(worker, {x0, y0, mx + 1, my + 1, true});
+                scheduler.push(worker, {mx, y0, x1, my + 1, true});
+                scheduler.push(worker, {x0, my, mx + 1, y1, true});
+                scheduler.push(worker, {mx, my, x1, y1, true});
+            }
+        };
+        
+        // Starts from the tile edges and follows region boundaries: a queued
+        // pixel has its four neighbors computed, and those that differ from
+        // it are queued too, as are the diagonals next to them. Enclosed
+        // regions are never entered; their pixels are then filled from the
+        // left, where a computed pixel of the same region always lies.
+        // Interior pixels only form regions inside the main cardioid and
+        // the period-2 bulb, whose periods come from the closed-form test.
+        // Elsewhere periodicity detection can report a multiple of the
+        // period for single pixels, and pixels without a detected period
+        // hide escaped pixels among them. Those count as differing from all
+        // their neighbors, so they are all computed.
+        auto traceTile = [&](const Tile& tile, WorkerStats& stats) {
+            enum : uint8_t { COMPUTED = 1, QUEUED = 2 };
+            const int width = tile.x1 - tile.x0;
+            const int height = tile.y1 - tile.y0;
+            std::vector<uint8_t> state(width * height);
+            std::vector<int> queue;
+            
+            auto index = [&](int x, int y) { return y * WINDOW_WIDTH + x; };
+            auto load = [&](int x, int y) {
+                uint8_t& flags = state[(y - tile.y0) * width + (x - tile.x0)];
+                if (!(flags & COMPUTED)) {
+                    computeSpan(y, x, x + 1, stats);
+                    flags |= COMPUTED;
+                }
+                return std::pair(iterationBuffer[index(x, y)], periodBuffer[index(x, y)]);
+            };
+            auto enqueue = [&](int x, int y) {
+                uint8_t& flags = state[(y - tile.y0) * width + (x - tile.x0)];
+                if (!(flags & QUEUED)) {
+                    flags |= QUEUED;
+                    queue.push_back((y - tile.y0) * width + (x - tile.x0));
+                }
+            };
+            
+            for (int x = tile.x0; x < tile.x1; ++x) {
+                enqueue(x, tile.y0);
+                enqueue(x, tile.y1 - 1);
+            }
+            for (int y = tile.y0 + 1; y < tile.y1 - 1; ++y) {
+                enqueue(tile.x0, y);
+                enqueue(tile.x1 - 1, y);
+            }
+            
+            while (!queue.empty() && !cancel.cancelled()) {
+                const int x = tile.x0 + queue.back() % width;
+                const int y = tile.y0 + queue.back() / width;
+                queue.pop_back();
+                
+                const auto center = load(x, y);
+                const bool undetermined = center.first == maxIterations && center.second != 1 && center.second != 2;
+                auto differs = [&](int nx, int ny) { return load(nx, ny) != center || undetermined; };
+                const bool hasLeft = x > tile.x0, hasRight = x < tile.x1 - 1;
+                const bool hasUp = y > tile.y0, hasDown = y < tile.y1 - 1;
+                const bool left = hasLeft && differs(x - 1, y);
+                const bool right = hasRight && differs(x + 1, y);
+                const bool up = hasUp && differs(x, y - 1);
+                const bool down = hasDown && differs(x, y + 1);
+                
+                if (left) enqueue(x - 1, y);
+                if (right) enqueue(x + 1, y);
+                if (up) enqueue(x, y - 1);
+                if (down) enqueue(x, y + 1);
+                if (hasUp && hasLeft && (up || left)) enqueue(x - 1, y - 1);
+                if (hasUp && hasRight && (up || right)) enqueue(x + 1, y - 1);
+                if (hasDown && hasLeft && (down || left)) enqueue(x - 1, y + 1);
+                if (hasDown && hasRight && (down || right)) enqueue(x + 1, y + 1);
+            }
+            if (cancel.cancelled()) return;
+            
+            for (int y = tile.y0; y < tile.y1; ++y) {
+                for (int x = tile.x0 + 1; x < tile.x1; ++x) {
+                    if (!(state[(y - tile.y0) * width + (x - tile.x0)] & COMPUTED)) {
+                        copyPixel(index(x, y), index(x - 1, y));
+                    }
+                }
+            }
+        };
+        
+        // Tiles overlapping the pixels kept from the last frame go through
+        // renderTile, which skips them
+        auto overlapsValidRegion = [&](const Tile& tile) {
+            return tile.x0 < validRegion.x1 && validRegion.x0 < tile.x1 &&
+                   tile.y0 < validRegion.y1 && validRegion.y0 < tile.y1;
+        };
+        
+        // Workers pull tiles until the pass is done. Once a newer request
+        // arrives they only drain the remaining tiles.
+        std::fill(workerStats.begin(), workerStats.end(), WorkerStats{});
+        auto runTiles = [&](const std::function<void(const Tile&, int, WorkerStats&)>& processTile) {
+            scheduler.reset(width, height, TILE_SIZE);
+            pool.run([&](int i) {
+                WorkerStats stats;
+                Tile tile;
+                bool stolen;
+                while (scheduler.next(i, tile, stolen)) {
+                    if (!cancel.cancelled()) {
+                        const auto tileStart = Clock::now();
+                        processTile(tile, i, stats);
+                        stats.busyMs += std::chrono::duration<double, std::milli>(Clock::now() - tileStart).count();
+                        stats.tiles++;
+                        stats.stolen += stolen;
+                    }
+                    scheduler.finished();
+                }
+                workerStats[i].busyMs += stats.busyMs;
+                workerStats[i].tiles += stats.tiles;
+                workerStats[i].stolen += stats.stolen;
+                workerStats[i].pixels += stats.pixels;
+                workerStats[i].glitches += stats.glitches;
+            });
+        };
+        
+        // The colorize pass only reads the iteration buffers, so palette
+        // changes repeat just this. A step above 1 colorizes the samples of a
+        // progressive pass as blocks.
+        auto colorizeFrame = [&](int step) {
+            const PaletteIndex index = buildPaletteIndex(width, height, step, maxIterations, coloring);
+            const int numWorkers = pool.size();
+            pool.run([&](int i) {
+                for (int y = i * step; y < height; y += numWorkers * step) {
+                    uint32_t* row = frame.row(y);
+                    const int offset = y * WINDOW_WIDTH;
+                    if (step == 1) {
+                        colorizeKernel(&iterationBuffer[offset], &smoothBuffer[offset], &interiorBuffer[offset],
+                                       width, index, row);
+                        if (showPeriods) {
+                            for (int x = 0; x < width; ++x) {
+                                if (periodBuffer[offset + x] != 0) row[x] = getPeriodColor(periodBuffer[offset + x]);
+                            }
+                        }
+                        continue;
+                    }
+                    for (int x = 0; x < width; x += step) {
+                        const uint32_t color = pixelColor(offset + x, index);
+                        std::fill(row + x, row + std::min(x + step, width), color);
+                    }
+                    for (int dy = 1; dy < step && y + dy < height; ++dy) {
+                        std::memcpy(frame.row(y + dy), row, width * sizeof(uint32_t));
+                    }
+                }
+            });
+        };
+        
+        if (progressive && mode == BRUTE_FORCE && fullRecompute && !interactive) {
+            // Coarse passes are shown only if the UI thread has already taken
+            // the previous frame
+            for (int step : PROGRESSIVE_STEPS) {
+                runTiles([&](const Tile& tile, int, WorkerStats& tileStats) {
+                    computeSamples(tile, step, tileStats);
+                });
+                if (step == 1 || cancel.cancelled() || !acquireFrame(frame, false)) continue;
+                
+                colorizeFrame(step);
+                if (stats.firstPassMs == 0) {
+                    stats.firstPassMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+                }
+                releaseFrame(true, divisor, false);
+            }
+        } else {
+            runTiles([&](const Tile& tile, int worker, WorkerStats& tileStats) {
+                if (mode == BRUTE_FORCE || (!tile.borderComputed && overlapsValidRegion(tile))) {
+                    renderTile(tile, tileStats);
+                } else if (mode == SUBDIVISION) {
+                    subdivideTile(tile, worker, tileStats);
+                } else {
+                    traceTile(tile, tileStats);
+                }
+            });
+        }
+        
+        // Iterations written by an abandoned frame are ignored: validRegion
+        // still only covers the pixels carried over from the previous frame.
+        // Its time is a lower bound on a whole frame though, so interactive
+        // frames that are always cancelled still lower the resolution.
+        if (cancel.cancelled()) {
+            const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+            fullFrameMs = std::max(fullFrameMs, elapsedMs * divisor * divisor);
+            return false;
+        }
+        if (!acquireFrame(frame, true)) {
+            return false;
         }
+        const auto colorizeStart = Clock::now();
+        colorizeFrame(1);
+        stats.colorizeMs = std::chrono::duration<double, std::milli>(Clock::now() - colorizeStart).count();
+        validRegion = {0, 0, width, height};
         
-        // Wait for all threads
-        for (auto& thread : threads) {
-            thread.join();
+        stats.frameMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+        if (fullRecompute) {
+            fullFrameMs = stats.frameMs * divisor * divisor;
         }
         
-        // Combine thread buffers into final image
-        for (int i = 0; i < numThreads; ++i) {
-            int startY = i * linesPerThread;
-            int endY = (i == numThreads - 1) ? WINDOW_HEIGHT : (i + 1) * linesPerThread;
-            int size = (endY - startY) * WINDOW_WIDTH;
-            std::copy(
-                threadBuffers[i].begin() + startY * WINDOW_WIDTH,
-                threadBuffers[i].begin() + endY * WINDOW_WIDTH,
-                tempPixels.begin() + startY * WINDOW_WIDTH
-            );
-        }
-        
-        // Atomic buffer swap and render
-        std::swap(pixels, tempPixels);
-        SDL_UpdateTexture(texture, nullptr, pixels.data(), WINDOW_WIDTH * sizeof(uint32_t));
+        finishedIterations = maxIterations;
+        slowEscapes = 0;
+        slowestEscape = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const int iterations = iterationBuffer[y * WINDOW_WIDTH + x];
+                if (iterations < maxIterations) {
+                    slowEscapes += iterations >= maxIterations / 2;
+                    slowestEscape = std::max(slowestEscape, iterations);
+                }
+            }
+        }
+        stats.iterationLimit = maxIterations;
+        stats.slowEscapes = slowEscapes;
+        for (auto& worker : workerStats) {
+            worker.idleMs = stats.frameMs - worker.busyMs;
+            stats.pixelsComputed += worker.pixels;
+            stats.glitchedPixels += worker.glitches;
+        }
+        stats.workers = workerStats;
+        {
+            std::lock_guard lock(statsMutex);
+            lastFrameStats = std::move(stats);
+            framesCompleted++;
+        }
+        releaseFrame(true, divisor, true);
+        return true;
+    }
+
+    // Render thread: always works on the newest requested view
+    void renderLoop() {
+        while (true) {
+            View view;
+            bool interactive;
+            uint64_t generation;
+            using Clock = std::chrono::steady_clock;
+            {
+                std::unique_lock lock(requestMutex);
+                requestCondition.wait(lock, [&] { return stopping || requestPending; });
+                if (stopping) return;
+                view = requestedView;
+                interactive = requestedInteractive;
+                generation = latestGeneration;
+                requestPending = false;
+            }
+            
+            const auto start = Clock::now();
+            if (!renderMandelbrot(view, interactive, CancellationToken(latestGeneration, generation))) {
+                std::lock_guard lock(statsMutex);
+                framesCancelled++;
+                cancelledMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                continue;
+            }
+            
+            // A still frame that cut off detail at its iteration limit is
+            // redone with the raised limit, unless a new request came in
+            const int pixelCount = (WINDOW_WIDTH / renderedDivisor) * (WINDOW_HEIGHT / renderedDivisor);
+            if (!interactive && chooseIterationLimit(view, pixelCount) > finishedIterations) {
+                std::lock_guard lock(requestMutex);
+                if (!requestPending) {
+                    requestedView = view;
+                    requestedInteractive = false;
+                    requestPending = true;
+                }
+            }
+        }
+    }
+
+    // Posts the current view to the render thread, superseding any request
+    // it has not finished yet
+    void requestRender(bool interactive = false) {
+        {
+            std::lock_guard lock(requestMutex);
+            requestedView = {centerX, centerY, zoom};
+            requestedInteractive = interactive;
+            requestPending = true;
+            ++latestGeneration;
+        }
+        requestCondition.notify_one();
+        renderRequests++;
+    }
+
+    // Points backTarget at the locked back texture, or at tempPixels for copy
+    // upload. Called with frameMutex held while the render thread is not
+    // using the target.
+    void provideBackTarget() {
+        if (backTargetLocked) {
+            SDL_UnlockTexture(textures[1 - frontTexture]);
+            backTargetLocked = false;
+        }
+        
+        if (zeroCopyUpload) {
+            void* texturePixels;
+            int texturePitch;
+            if (SDL_LockTexture(textures[1 - frontTexture], nullptr, &texturePixels, &texturePitch) == 0) {
+                backTarget = {static_cast<uint8_t*>(texturePixels), texturePitch};
+                backTargetLocked = true;
+                return;
+            }
+            std::cerr << "SDL_LockTexture failed, using copy upload: " << SDL_GetError() << std::endl;
+            zeroCopyUpload = false;
+        }
+        backTarget = {reinterpret_cast<uint8_t*>(tempPixels.data()), WINDOW_WIDTH * sizeof(uint32_t)};
+    }
+
+    // Shows the newest finished frame, if any, and re-presents the front texture
+    void presentFrame() {
+        {
+            std::lock_guard lock(frameMutex);
+            if (frameReady) {
+                if (backTargetLocked) {
+                    // The frame never touched tempPixels: no write to it, no read back
+                    SDL_UnlockTexture(textures[1 - frontTexture]);
+                    backTargetLocked = false;
+                    frontTexture = 1 - frontTexture;
+                    lastFrameBytesSaved = FRAME_BYTES_SAVED / (readyDivisor * readyDivisor);
+                    uploadBytesSaved += lastFrameBytesSaved;
+                    lastFrameZeroCopy = true;
+                } else {
+                    // Atomic buffer swap and render
+                    std::swap(pixels, tempPixels);
+                    SDL_UpdateTexture(textures[frontTexture], nullptr, pixels.data(), WINDOW_WIDTH * sizeof(uint32_t));
+                    lastFrameBytesSaved = 0;
+                    lastFrameZeroCopy = false;
+                }
+                frontDivisor = readyDivisor;
+                frameReady = false;
+                provideBackTarget();
+            }
+        }
+        frameCondition.notify_all();
+        
+        const SDL_Rect source{0, 0, WINDOW_WIDTH / frontDivisor, WINDOW_HEIGHT / frontDivisor};
         SDL_RenderClear(renderer);
-        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+        SDL_RenderCopy(renderer, textures[frontTexture], &source, nullptr);
         SDL_RenderPresent(renderer);
     }
 
+    // Advances the wheel zoom animation by the time since its last step and
+    // requests the resulting view
+    void stepZoomAnimation() {
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsedMs = std::chrono::duration<double, std::milli>(now - lastZoomStep).count();
+        lastZoomStep = now;
+        
+        // The anchor's offset from the center at zoom 1; the center moves by
+        // the change of that offset in view coordinates
+        const double anchorX = (zoomAnchor.x - WINDOW_WIDTH/2.0) / (WINDOW_WIDTH/4.0);
+        const double anchorY = (zoomAnchor.y - WINDOW_HEIGHT/2.0) / (WINDOW_WIDTH/4.0);
+        const FloatExp oldZoom = zoom;
+        
+        // Interpolate in log space so zooming in and out feel the same
+        const double remaining = std::log((zoomTarget / zoom).toDouble());
+        const double step = remaining * (1.0 - std::exp(-elapsedMs / ZOOM_SMOOTHING_MS));
+        if (std::abs(remaining - step) < 1e-3) {
+            zoom = zoomTarget;
+            zoomAnimating = false;
+        } else {
+            zoom *= std::exp(step);
+        }
+        
+        const int precision = std::max(centerX.precision(), precisionForZoom(zoom));
+        centerX.setPrecision(precision);
+        centerY.setPrecision(precision);
+        centerX += anchorX / oldZoom - anchorX / zoom;
+        centerY += anchorY / oldZoom - anchorY / zoom;
+        viewChanged = true;
+        interactiveChange = true;
+    }
+    
+    // Advances the color cycle by the time since its last step and asks
+    // for the view to be recolored
+    void stepColorCycle() {
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - lastCycleStep).count();
+        lastCycleStep = now;
+        colorCycle = std::fmod(colorCycle + elapsed * COLOR_CYCLES_PER_SECOND, 1.0);
+        viewChanged = true;
+    }
+    
+    // Pans by the net mouse movement since the last batch
+    // Moves the view by the drag in whole pixels of the grid the shown
+    // frame was rendered on, so renderMandelbrot can shift that frame's
+    // pixels; at reduced resolution a screen pixel is a fraction of one.
+    // The rest is kept for the next drag, and applied in full on release.
+    void applyDrag() {
+        dragRemainderX += dragCurrent.x - dragStart.x;
+        dragRemainderY += dragCurrent.y - dragStart.y;
+        dragStart = dragCurrent;
+        if (dragRemainderX == 0 && dragRemainderY == 0) return;
+        
+        const double gridPixel = static_cast<double>(WINDOW_WIDTH) / (WINDOW_WIDTH / frontDivisor);
+        double dx = dragRemainderX, dy = dragRemainderY;
+        if (isDragging) {
+            dx = std::trunc(dx / gridPixel) * gridPixel;
+            dy = std::trunc(dy / gridPixel) * gridPixel;
+            if (dx == 0 && dy == 0) return;
+        }
+        dragRemainderX -= dx;
+        dragRemainderY -= dy;
+        centerX -= dx / (zoom * (WINDOW_WIDTH/4.0));
+        centerY -= dy / (zoom * (WINDOW_WIDTH/4.0));
+        viewChanged = true;
+        interactiveChange = true;
+    }
+
+    void toggleUploadMode() {
+        {
+            std::lock_guard lock(frameMutex);
+            zeroCopyUpload = !zeroCopyUpload;
+            // While the render thread owns the back buffer, presentFrame
+            // switches it over instead
+            if (!frameInProgress && !frameReady) {
+                provideBackTarget();
+            }
+        }
+        std::cout << "Upload: " << (zeroCopyUpload ? "zero-copy" : "copy") << std::endl;
+        viewChanged = true;
+    }
+
+    void cycleFillMode() {
+        fillMode = static_cast<FillMode>((fillMode + 1) % FILL_MODE_COUNT);
+        std::cout << "Fill mode: " << FILL_MODE_NAMES[fillMode]
+                  << (smoothColoring && fillMode != BRUTE_FORCE ? " (brute force while smooth coloring is on)" : "")
+                  << std::endl;
+        viewChanged = true;
+    }
+
+    // Doubles or halves the manual iteration limit, starting from the one
+    // picked for the last frame; 0 goes back to picking it automatically
+    void setIterationOverride(int direction) {
+        int limit = 0;
+        if (direction != 0) {
+            {
+                std::lock_guard lock(statsMutex);
+                limit = iterationOverride > 0 ? iterationOverride.load()
+                                              : std::max(lastFrameStats.iterationLimit, MIN_ITERATIONS);
+            }
+            limit = direction > 0 ? limit * 2 : limit / 2;
+            limit = std::clamp(limit, 1, MAX_ITERATION_LIMIT);
+        }
+        iterationOverride = limit;
+        if (limit > 0) {
+            std::cout << "Iteration limit: " << limit << std::endl;
+        } else {
+            std::cout << "Iteration limit: automatic" << std::endl;
+        }
+        viewChanged = true;
+    }
+
+    void toggleColorCycling() {
+        colorCycling = !colorCycling;
+        lastCycleStep = std::chrono::steady_clock::now();
+        std::cout << "Color cycling: " << (colorCycling ? "on" : "off") << std::endl;
+        viewChanged = true;
+    }
+
+    void scalePaletteDensity(double factor) {
+        paletteDensity = paletteDensity * factor;
+        std::cout << "Palette density: " << paletteDensity << std::endl;
+        viewChanged = true;
+    }
+
+    void printStats() {
+        std::lock_guard lock(statsMutex);
+        const int divisor = lastFrameStats.resolutionDivisor;
+        std::cout << "Frame: " << lastFrameStats.frameMs << " ms";
+        if (lastFrameStats.firstPassMs > 0) {
+            std::cout << " (first pass shown after " << lastFrameStats.firstPassMs << " ms)";
+        }
+        if (divisor > 1) {
+            std::cout << " at 1/" << divisor << " resolution";
+        }
+        std::cout << ", computed " << lastFrameStats.pixelsComputed
+                  << " of " << (WINDOW_WIDTH / divisor) * (WINDOW_HEIGHT / divisor) << " pixels" << std::endl;
+        const int digits = 17 + static_cast<int>(std::max(zoom.log2(), 0.0) * std::log10(2.0));
+        std::cout << "View: center " << centerX.toString(digits) << ", " << centerY.toString(digits)
+                  << ", zoom " << zoom << std::endl;
+        if (lastFrameStats.referenceIterations > 0) {
+            std::cout << "Perturbation: reference orbit of " << lastFrameStats.referenceIterations << " iterations, ";
+            if (lastFrameStats.referenceMs > 0) {
+                std::cout << "computed in " << lastFrameStats.referenceMs << " ms";
+            } else {
+                std::cout << "reused";
+            }
+            std::cout << ", series skips " << lastFrameStats.seriesSkip << " iterations (" << lastFrameStats.seriesMs
+                      << " ms), bilinear table of " << lastFrameStats.bilinearLevels << " levels ";
+            if (lastFrameStats.bilinearMs > 0) {
+                std::cout << "built in " << lastFrameStats.bilinearMs << " ms";
+            } else {
+                std::cout << "reused";
+            }
+            std::cout << ", " << lastFrameStats.glitchedPixels << " glitched pixels rebased"
+                      << (lastFrameStats.extendedRange ? ", FloatExp deltas" : "") << std::endl;
+        }
+        std::cout << "Colorize: " << lastFrameStats.colorizeMs << " ms, "
+                  << (smoothColoring ? "smooth" : "banded")
+                  << (histogramEqualization ? ", equalized" : "") << std::endl;
+        std::cout << "Iterations: limit " << lastFrameStats.iterationLimit
+                  << (iterationOverride > 0 ? " (manual)" : " (automatic)") << ", "
+                  << lastFrameStats.slowEscapes << " pixels escaped in its top half" << std::endl;
+        std::cout << "Jobs: " << framesCompleted << " completed, " << framesCancelled
+                  << " cancelled after " << cancelledMs << " ms of work" << std::endl;
+        std::cout << "Input: " << inputEvents << " events coalesced into "
+                  << renderRequests << " render requests" << std::endl;
+        std::cout << "Upload: " << (lastFrameZeroCopy ? "zero-copy" : "copy")
+                  << ", saved " << lastFrameBytesSaved / (1024.0 * 1024.0) << " MB this frame"
+                  << ", " << uploadBytesSaved / (1024.0 * 1024.0) << " MB total" << std::endl;
+        for (size_t i = 0; i < lastFrameStats.workers.size(); ++i) {
+            const WorkerStats& stats = lastFrameStats.workers[i];
+            std::cout << "  worker " << i
+                      << ": busy " << stats.busyMs << " ms"
+                      << ", idle " << stats.idleMs << " ms"
+                      << ", tiles " << stats.tiles
+                      << " (" << stats.stolen << " stolen)"
+                      << ", pixels " << stats.pixels << std::endl;
+        }
+    }
+
 public:
-    MandelbrotExplorer() 
+    // Times every supported kernel with each interior shortcut on a single
+    // thread, on the startup view and on a period-3 minibrot, then the
+    // colorize kernels on the startup view. Needs no window.
+    static int benchmark() {
+        constexpr int RUNS = 3;
+        const std::pair<const char*, View> views[] = {
+            {"Startup view", {-0.5, 0.0, 1.0}},
+            {"Period-3 minibrot", {-1.7548776662466927, 0.0, 120.0}},
+        };
+        const std::pair<const char*, int> featureSets[] = {
+            {"no shortcuts", 0},
+            {"interior check", INTERIOR_CHECK},
+            {"interior + periodicity", ALL_KERNEL_FEATURES},
+        };
+        
+        const std::atomic<uint64_t> generation{0};
+        const CancellationToken cancel(generation, 0);
+        std::vector<double> rowReal(WINDOW_WIDTH);
+        std::vector<int> periods(WINDOW_WIDTH * WINDOW_HEIGHT);
+        std::vector<float> norms(WINDOW_WIDTH * WINDOW_HEIGHT);
+        auto timeKernel = [&](const View& view, RowKernel kernel, std::vector<int>& iterations) {
+            const double scale = view.zoom.toDouble() * WINDOW_WIDTH/4.0;
+            for (int x = 0; x < WINDOW_WIDTH; ++x) {
+                rowReal[x] = (x - WINDOW_WIDTH/2.0) / scale + view.centerX.toDouble();
+            }
+            
+            double best = 1e300;
+            for (int run = 0; run < RUNS; ++run) {
+                const auto start = std::chrono::steady_clock::now();
+                for (int y = 0; y < WINDOW_HEIGHT; ++y) {
+                    double imag = (y - WINDOW_HEIGHT/2.0) / scale + view.centerY.toDouble();
+                    kernel(rowReal.data(), imag, WINDOW_WIDTH, REFERENCE_ITERATIONS, &iterations[y * WINDOW_WIDTH],
+                           &periods[y * WINDOW_WIDTH], &norms[y * WINDOW_WIDTH], cancel);
+                }
+                best = std::min(best, std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+            return best;
+        };
+        
+        std::vector<int> plain(WINDOW_WIDTH * WINDOW_HEIGHT);
+        std::vector<int> iterations(WINDOW_WIDTH * WINDOW_HEIGHT);
+        for (const auto& [viewName, view] : views) {
+            std::cout << viewName << ", " << WINDOW_WIDTH << "x" << WINDOW_HEIGHT
+                      << ", best of " << RUNS << " single-threaded runs" << std::endl;
+            for (const KernelVariant& variant : supportedRowKernels()) {
+                const double plainMs = timeKernel(view, variant.kernels[0], plain);
+                for (const auto& [featureName, features] : featureSets) {
+                    const double ms = timeKernel(view, variant.kernels[features], iterations);
+                    const auto mismatches = std::inner_product(plain.begin(), plain.end(), iterations.begin(), 0L,
+                                                               std::plus<>(), std::not_equal_to<>());
+                    std::cout << "  " << variant.name << ", " << featureName << ": " << ms << " ms ("
+                              << plainMs / ms << "x), " << mismatches << " pixels differ" << std::endl;
+                }
+            }
+        }
+        
+        // Colorizing the startup view, against the per-pixel trig the
+        // palette table replaces
+        timeKernel(views[0].second, supportedRowKernels().front().kernels[ALL_KERNEL_FEATURES], iterations);
+        const EscapeData data = escapeData(iterations, norms, REFERENCE_ITERATIONS);
+        std::vector<uint32_t> colors(WINDOW_WIDTH * WINDOW_HEIGHT);
+        auto timeColorize = [&](auto&& colorize) {
+            double best = 1e300;
+            for (int run = 0; run < RUNS; ++run) {
+                const auto start = std::chrono::steady_clock::now();
+                colorize();
+                best = std::min(best, std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+            return best;
+        };
+        std::cout << "Colorize, " << views[0].first << ", best of " << RUNS << " single-threaded runs" << std::endl;
+        const double trigMs = timeColorize([&] {
+            for (size_t i = 0; i < colors.size(); ++i) {
+                const int n = data.iterations[i];
+                colors[i] = data.interior[i] ? 0 : paletteColor((n + 1 - std::log2(std::log2(std::max(n, 2)))) /
+                                                                ITERATIONS_PER_PALETTE_CYCLE);
+            }
+        });
+        std::cout << "  per-pixel trig: " << trigMs << " ms" << std::endl;
+        std::vector<uint32_t> positions;
+        for (const auto& [kernelName, kernel] : supportedColorizeKernels()) {
+            for (bool smooth : {false, true}) {
+                const Coloring coloring{smooth, false, true, 1.0, 0.0};
+                const double ms = timeColorize([&] {
+                    fillPalettePositions(positions, REFERENCE_ITERATIONS, coloring, {});
+                    const PaletteIndex index{positions.data(), paletteTable(), REFERENCE_ITERATIONS, smooth, true};
+                    colorizeEscapeData(kernel, data, index, colors);
+                });
+                std::cout << "  " << kernelName << " table, " << (smooth ? "smooth" : "banded") << ": " << ms
+                          << " ms (" << trigMs / ms << "x)" << std::endl;
+            }
+        }
+        return 0;
+    }
+
+    // Compares every kernel against calculateMandelbrotReference on a set of
+    // reference views. Fails if more than VERIFY_TOLERANCE of the pixels of
+    // any view differ; single boundary pixels may round either way. The
+    // colorize kernels must match the scalar one exactly.
+    static int verify() {
+        constexpr double VERIFY_TOLERANCE = 1e-4;
+        const std::pair<const char*, View> views[] = {
+            {"Startup view", {-0.5, 0.0, 1.0}},
+            {"Period-3 minibrot", {-1.7548776662466927, 0.0, 120.0}},
+            {"Seahorse valley", {-0.745, 0.1, 100.0}},
+            {"Elephant valley", {0.275, 0.007, 200.0}},
+            {"Spiral", {-0.7436438870371587, 0.1318259042053119, 1e6}},
+        };
+        // Perturbation is checked on samples, which may differ on the boundary
+        constexpr int DEEP_SAMPLE_STEP = 40;
+        constexpr double DEEP_TOLERANCE = 1e-2;
+        // Deep views set their own iteration limit: at the one picked for
+        // the zoom, the whole deep spiral is interior. Around the Misiurewicz
+        // point i pixels escape after about 2.6 iterations per decade of zoom.
+        struct DeepView {
+            const char* name;
+            const char* centerX;
+            const char* centerY;
+            FloatExp zoom;
+            int maxIterations;
+        };
+        const DeepView deepViews[] = {
+            {"Deep spiral", "-0.743643887037158704752191506114774", "0.131825904205311970493132056385139", 1e20, 20000},
+            {"Period-8007 minibrot", "-0.74364388703715870475219150611477977821525620",
+             "0.13182590420531197049313205638514067897295227", 1e32, 50000},
+            {"Misiurewicz point i", "0", "1", FloatExp(1e200) * 1e200, 3000},
+        };
+        
+        const std::atomic<uint64_t> generation{0};
+        const CancellationToken cancel(generation, 0);
+        std::vector<double> rowReal(WINDOW_WIDTH);
+        std::vector<int> reference(WINDOW_WIDTH * WINDOW_HEIGHT);
+        std::vector<int> iterations(WINDOW_WIDTH * WINDOW_HEIGHT);
+        std::vector<int> periods(WINDOW_WIDTH * WINDOW_HEIGHT);
+        std::vector<float> norms(WINDOW_WIDTH * WINDOW_HEIGHT);
+        std::vector<uint32_t> positions;
+        std::vector<uint32_t> expectedColors(WINDOW_WIDTH * WINDOW_HEIGHT);
+        std::vector<uint32_t> colors(WINDOW_WIDTH * WINDOW_HEIGHT);
+        bool passed = true;
+        
+        // Renders a whole view by perturbation against its center and returns
+        // the iterations skipped by the series and the number of glitched
+        // pixels
+        auto renderPerturbed = [&](const View& view, int maxIterations) {
+            const int precision = precisionForZoom(view.zoom);
+            FixedPoint cx = view.centerX, cy = view.centerY;
+            cx.setPrecision(precision);
+            cy.setPrecision(precision);
+            ReferenceOrbit orbit;
+            computeReferenceOrbit(orbit, cx, cy, maxIterations, cancel);
+            
+            const FloatExp spacing = 1.0 / (view.zoom * (WINDOW_WIDTH/4.0));
+            for (int x = 0; x < WINDOW_WIDTH; ++x) {
+                rowReal[x] = x - WINDOW_WIDTH/2.0;
+            }
+            auto imagAt = [&](int y) { return y - WINDOW_HEIGHT/2.0; };
+            SeriesApproximation series;
+            computeSeriesApproximation(series, orbit, {{{rowReal[0], imagAt(0)},
+                                                        {rowReal[WINDOW_WIDTH - 1], imagAt(0)},
+                                                        {rowReal[0], imagAt(WINDOW_HEIGHT - 1)},
+                                                        {rowReal[WINDOW_WIDTH - 1], imagAt(WINDOW_HEIGHT - 1)}}},
+                                       spacing, maxIterations, cancel);
+            BilinearTable table;
+            buildBilinearTable(table, orbit, series.radius * spacing, cancel);
+            const auto kernel = view.zoom >= EXTENDED_RANGE_ZOOM ? calculateRowPerturbed<FloatExp>
+                                                                 : calculateRowPerturbed<double>;
+            int glitches = 0;
+            for (int y = 0; y < WINDOW_HEIGHT; ++y) {
+                glitches += kernel(orbit, series, table, spacing, rowReal.data(), imagAt(y), WINDOW_WIDTH,
+                                   maxIterations, &iterations[y * WINDOW_WIDTH], &periods[y * WINDOW_WIDTH],
+                                   &norms[y * WINDOW_WIDTH], cancel);
+            }
+            return std::pair{series.skip, glitches};
+        };
+        
+        // Perturbation is checked against the reference loop run in fixed
+        // point, on every DEEP_SAMPLE_STEP-th pixel. Doubles would round the
+        // pixels' coordinates differently, which changes boundary pixels.
+        auto checkPerturbation = [&](const View& view, int maxIterations) {
+            const auto [skip, glitches] = renderPerturbed(view, maxIterations);
+            const int precision = precisionForZoom(view.zoom);
+            const FloatExp spacing = 1.0 / (view.zoom * (WINDOW_WIDTH/4.0));
+            ReferenceOrbit pixel;
+            int samples = 0, mismatches = 0;
+            for (int y = DEEP_SAMPLE_STEP / 2; y < WINDOW_HEIGHT; y += DEEP_SAMPLE_STEP) {
+                for (int x = DEEP_SAMPLE_STEP / 2; x < WINDOW_WIDTH; x += DEEP_SAMPLE_STEP) {
+                    const FloatExp offsetX = (x - WINDOW_WIDTH/2.0) * spacing;
+                    const FloatExp offsetY = (y - WINDOW_HEIGHT/2.0) * spacing;
+                    computeReferenceOrbit(pixel, view.centerX + FixedPoint(offsetX, precision),
+                                          view.centerY + FixedPoint(offsetY, precision), maxIterations, cancel);
+                    const int expected = pixel.escaped ? pixel.length() - 1 : maxIterations;
+                    mismatches += iterations[y * WINDOW_WIDTH + x] != expected;
+                    samples++;
+                }
+            }
+            const bool ok = mismatches <= DEEP_TOLERANCE * samples;
+            std::cout << "  perturbation: " << skip << " iterations skipped, " << mismatches << " of " << samples
+                      << " samples differ, " << glitches << " pixels glitched" << (ok ? "" : " FAILED") << std::endl;
+            return ok;
+        };
+        
+        // The fill modes are checked through renderMandelbrot, against its
+        // brute-force frame. Boundary tracing must match it exactly in escape
+        // time and period. Subdivision fills rectangles whose border is
+        // uniform without looking inside, so it may miss small features:
+        // it is allowed FILL_TOLERANCE of the pixels in escape time, and
+        // ten times that in period, which is noisier.
+        constexpr double FILL_TOLERANCE = 1e-4;
+        MandelbrotExplorer renderer(Headless{});
+        renderer.iterationOverride = REFERENCE_ITERATIONS;
+        // Nothing shows the coarse passes, so the final one would wait
+        renderer.progressive = false;
+        auto renderFrame = [&](const View& view, FillMode mode) {
+            renderer.fillMode = mode;
+            renderer.renderMandelbrot(view, false, cancel);
+            renderer.frameReady = false;
+        };
+        auto checkFillModes = [&](const View& view) {
+            bool ok = true;
+            renderFrame(view, BRUTE_FORCE);
+            const std::vector<int> expectedIterations = renderer.iterationBuffer;
+            const std::vector<int> expectedPeriods = renderer.periodBuffer;
+            const std::vector<float> expectedSmooth = renderer.smoothBuffer;
+            for (FillMode mode : {SUBDIVISION, BOUNDARY_TRACE}) {
+                renderFrame(view, mode);
+                const auto iterationMismatches = std::inner_product(
+                    expectedIterations.begin(), expectedIterations.end(), renderer.iterationBuffer.begin(), 0L,
+                    std::plus<>(), std::not_equal_to<>());
+                const auto periodMismatches = std::inner_product(
+                    expectedPeriods.begin(), expectedPeriods.end(), renderer.periodBuffer.begin(), 0L,
+                    std::plus<>(), std::not_equal_to<>());
+                const double tolerance = mode == SUBDIVISION ? FILL_TOLERANCE * expectedIterations.size() : 0;
+                const bool modeOk = iterationMismatches <= tolerance && periodMismatches <= 10 * tolerance;
+                ok = ok && modeOk;
+                std::cout << "  " << FILL_MODE_NAMES[mode] << ": " << iterationMismatches << " escape times and "
+                          << periodMismatches << " periods differ" << (modeOk ? "" : " FAILED") << std::endl;
+            }
+            
+            // Smooth coloring needs every pixel's own final |z|
+            renderer.smoothColoring = true;
+            for (FillMode mode : {SUBDIVISION, BOUNDARY_TRACE}) {
+                renderFrame(view, mode);
+                const auto smoothMismatches = std::inner_product(
+                    expectedSmooth.begin(), expectedSmooth.end(), renderer.smoothBuffer.begin(), 0L,
+                    std::plus<>(), std::not_equal_to<>());
+                ok = ok && smoothMismatches == 0;
+                std::cout << "  " << FILL_MODE_NAMES[mode] << ", smooth coloring: " << smoothMismatches
+                          << " smooth escape times differ" << (smoothMismatches == 0 ? "" : " FAILED") << std::endl;
+            }
+            renderer.smoothColoring = false;
+            return ok;
+        };
+        
+        for (const auto& [viewName, view] : views) {
+            const double scale = view.zoom.toDouble() * WINDOW_WIDTH/4.0;
+            for (int x = 0; x < WINDOW_WIDTH; ++x) {
+                rowReal[x] = (x - WINDOW_WIDTH/2.0) / scale + view.centerX.toDouble();
+            }
+            for (int y = 0; y < WINDOW_HEIGHT; ++y) {
+                double imag = (y - WINDOW_HEIGHT/2.0) / scale + view.centerY.toDouble();
+                for (int x = 0; x < WINDOW_WIDTH; ++x) {
+                    reference[y * WINDOW_WIDTH + x] = calculateMandelbrotReference({rowReal[x], imag},
+                                                                                   REFERENCE_ITERATIONS);
+                }
+            }
+            
+            std::cout << viewName << std::endl;
+            for (const KernelVariant& variant : supportedRowKernels()) {
+                for (int features = 0; features <= ALL_KERNEL_FEATURES; ++features) {
+                    for (int y = 0; y < WINDOW_HEIGHT; ++y) {
+                        double imag = (y - WINDOW_HEIGHT/2.0) / scale + view.centerY.toDouble();
+                        variant.kernels[features](rowReal.data(), imag, WINDOW_WIDTH, REFERENCE_ITERATIONS,
+                                                  &iterations[y * WINDOW_WIDTH], &periods[y * WINDOW_WIDTH],
+                                                  &norms[y * WINDOW_WIDTH], cancel);
+                    }
+                    const auto mismatches = std::inner_product(reference.begin(), reference.end(), iterations.begin(), 0L,
+                                                               std::plus<>(), std::not_equal_to<>());
+                    const bool ok = mismatches <= VERIFY_TOLERANCE * reference.size();
+                    passed = passed && ok;
+                    std::cout << "  " << variant.name << ", features " << features << ": "
+                              << mismatches << " pixels differ" << (ok ? "" : " FAILED") << std::endl;
+                }
+            }
+            
+            const EscapeData data = escapeData(iterations, norms, REFERENCE_ITERATIONS);
+            for (bool smooth : {false, true}) {
+                const Coloring coloring{smooth, false, true, 1.0, 0.0};
+                fillPalettePositions(positions, REFERENCE_ITERATIONS, coloring, {});
+                const PaletteIndex index{positions.data(), paletteTable(), REFERENCE_ITERATIONS, smooth, true};
+                colorizeEscapeData(colorizeRowScalar, data, index, expectedColors);
+                for (const auto& [kernelName, kernel] : supportedColorizeKernels()) {
+                    colorizeEscapeData(kernel, data, index, colors);
+                    const auto mismatches = std::inner_product(expectedColors.begin(), expectedColors.end(),
+                                                               colors.begin(), 0L, std::plus<>(), std::not_equal_to<>());
+                    passed = passed && mismatches == 0;
+                    std::cout << "  " << kernelName << " colorize, " << (smooth ? "smooth" : "banded") << ": "
+                              << mismatches << " pixels differ" << (mismatches == 0 ? "" : " FAILED") << std::endl;
+                }
+            }
+            
+            // Perturbation glitches the most at shallow zooms, where the
+            // reference orbit differs most from the pixels' orbits
+            passed = checkPerturbation(view, REFERENCE_ITERATIONS) && passed;
+            passed = checkFillModes(view) && passed;
+        }
+        
+        for (const auto& [viewName, re, im, zoom, maxIterations] : deepViews) {
+            const int precision = precisionForZoom(zoom);
+            const View view{FixedPoint::parse(re, precision), FixedPoint::parse(im, precision), zoom};
+            std::cout << viewName << ", zoom " << zoom << ", limit " << maxIterations
+                      << (zoom >= EXTENDED_RANGE_ZOOM ? ", FloatExp deltas" : "") << std::endl;
+            passed = checkPerturbation(view, maxIterations) && passed;
+        }
+        return passed ? 0 : 1;
+    }
+
+    // Without a window or render thread: renderMandelbrot() draws into
+    // tempPixels and the frame is never presented. For --verify.
+    struct Headless {};
+    explicit MandelbrotExplorer(Headless)
         : pixels(WINDOW_WIDTH * WINDOW_HEIGHT)
-        , tempPixels(WINDOW_WIDTH * WINDOW_HEIGHT) {
+        , tempPixels(WINDOW_WIDTH * WINDOW_HEIGHT)
+        , pool(std::max(1u, std::thread::hardware_concurrency()))
+        , scheduler(pool.size())
+        , iterationBuffer(WINDOW_WIDTH * WINDOW_HEIGHT)
+        , periodBuffer(WINDOW_WIDTH * WINDOW_HEIGHT)
+        , normBuffer(WINDOW_WIDTH * WINDOW_HEIGHT)
+        , smoothBuffer(WINDOW_WIDTH * WINDOW_HEIGHT)
+        , interiorBuffer(WINDOW_WIDTH * WINDOW_HEIGHT)
+        , workerStats(pool.size()) {
+        rowKernel = supportedRowKernels().front().kernels[ALL_KERNEL_FEATURES];
+        colorizeKernel = supportedColorizeKernels().front().second;
+        zeroCopyUpload = false;
+        provideBackTarget();
+    }
+    
+    MandelbrotExplorer() : MandelbrotExplorer(Headless{}) {
         if (SDL_Init(SDL_INIT_VIDEO) < 0) {
             throw std::runtime_error(std::string("SDL initialization failed: ") + SDL_GetError());
         }
@@ -130,17 +2926,49 @@ public:
             throw std::runtime_error(std::string("Hardware renderer creation failed: ") + SDL_GetError());
         }
 
-        texture = SDL_CreateTexture(renderer,
-                                  SDL_PIXELFORMAT_RGB888,
-                                  SDL_TEXTUREACCESS_STREAMING,
-                                  WINDOW_WIDTH, WINDOW_HEIGHT);
-        if (!texture) {
-            throw std::runtime_error("Texture creation failed");
+        // Reduced-resolution frames are scaled up with filtering instead of
+        // showing blocks
+        SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+        for (SDL_Texture*& texture : textures) {
+            texture = SDL_CreateTexture(renderer,
+                                      SDL_PIXELFORMAT_RGB888,
+                                      SDL_TEXTUREACCESS_STREAMING,
+                                      WINDOW_WIDTH, WINDOW_HEIGHT);
+            if (!texture) {
+                throw std::runtime_error("Texture creation failed");
+            }
+        }
+        
+        frameReadyEvent = SDL_RegisterEvents(1);
+        if (frameReadyEvent == static_cast<Uint32>(-1)) {
+            throw std::runtime_error("Event registration failed");
         }
+        
+        std::cout << "Using " << supportedRowKernels().front().name << " kernel" << std::endl;
+        
+        zeroCopyUpload = true;
+        provideBackTarget();
+        renderThread = std::thread(&MandelbrotExplorer::renderLoop, this);
     }
     
     ~MandelbrotExplorer() {
-        SDL_DestroyTexture(texture);
+        {
+            std::lock_guard requestLock(requestMutex);
+            std::lock_guard frameLock(frameMutex);
+            stopping = true;
+            ++latestGeneration;
+        }
+        requestCondition.notify_all();
+        frameCondition.notify_all();
+        if (renderThread.joinable()) renderThread.join();
+        if (!window) return;
+        
+        if (backTargetLocked) {
+            SDL_UnlockTexture(textures[1 - frontTexture]);
+        }
+        for (SDL_Texture* texture : textures) {
+            SDL_DestroyTexture(texture);
+        }
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         SDL_Quit();
@@ -150,27 +2978,81 @@ public:
         bool running = true;
         SDL_Event event;
         
-        renderMandelbrot();
+        requestRender();
         
+        // Rendering happens on the render thread, so the UI only sleeps until
+        // the next input event or finished frame. Everything queued by then is
+        // handled as one batch. After interaction it wakes up once input has
+        // been idle long enough to ask for the full-resolution frame.
         while (running) {
-            while (SDL_PollEvent(&event)) {
+            int timeoutMs = -1;
+            if (fullResolutionPending) {
+                const double idleMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - lastInteraction).count();
+                if (idleMs >= INTERACTION_IDLE_MS) {
+                    fullResolutionPending = false;
+                    requestRender();
+                } else {
+                    timeoutMs = static_cast<int>(std::ceil(INTERACTION_IDLE_MS - idleMs));
+                }
+            }
+            if (!(timeoutMs < 0 ? SDL_WaitEvent(&event) : SDL_WaitEventTimeout(&event, timeoutMs))) continue;
+            do {
                 switch (event.type) {
                     case SDL_QUIT:
                     case SDL_WINDOWEVENT:
                         if (event.window.event == SDL_WINDOWEVENT_CLOSE) {
                             running = false;
+                        } else if (event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+                            presentFrame();
                         }
                         break;
                         
                     case SDL_KEYDOWN:
                         if (event.key.keysym.sym == SDLK_ESCAPE) {
                             running = false;
+                        } else if (event.key.keysym.sym == SDLK_s) {
+                            printStats();
+                        } else if (event.key.keysym.sym == SDLK_u) {
+                            toggleUploadMode();
+                        } else if (event.key.keysym.sym == SDLK_p) {
+                            showPeriods = !showPeriods;
+                            viewChanged = true;
+                        } else if (event.key.keysym.sym == SDLK_m) {
+                            cycleFillMode();
+                        } else if (event.key.keysym.sym == SDLK_RIGHTBRACKET) {
+                            setIterationOverride(1);
+                        } else if (event.key.keysym.sym == SDLK_LEFTBRACKET) {
+                            setIterationOverride(-1);
+                        } else if (event.key.keysym.sym == SDLK_i) {
+                            setIterationOverride(0);
+                        } else if (event.key.keysym.sym == SDLK_r) {
+                            progressive = !progressive;
+                            std::cout << "Progressive refinement: " << (progressive ? "on" : "off") << std::endl;
+                        } else if (event.key.keysym.sym == SDLK_c) {
+                            smoothColoring = !smoothColoring;
+                            std::cout << "Smooth coloring: " << (smoothColoring ? "on" : "off") << std::endl;
+                            viewChanged = true;
+                        } else if (event.key.keysym.sym == SDLK_l) {
+                            paletteInterpolation = !paletteInterpolation;
+                            std::cout << "Palette interpolation: " << (paletteInterpolation ? "on" : "off") << std::endl;
+                            viewChanged = true;
+                        } else if (event.key.keysym.sym == SDLK_h) {
+                            histogramEqualization = !histogramEqualization;
+                            std::cout << "Histogram equalization: " << (histogramEqualization ? "on" : "off") << std::endl;
+                            viewChanged = true;
+                        } else if (event.key.keysym.sym == SDLK_SPACE) {
+                            toggleColorCycling();
+                        } else if (event.key.keysym.sym == SDLK_EQUALS) {
+                            scalePaletteDensity(PALETTE_DENSITY_STEP);
+                        } else if (event.key.keysym.sym == SDLK_MINUS) {
+                            scalePaletteDensity(1.0 / PALETTE_DENSITY_STEP);
                         }
                         break;
 
                     case SDL_MOUSEBUTTONDOWN:
                         if (event.button.button == SDL_BUTTON_LEFT) {
-                            dragStart = {event.button.x, event.button.y};
+                            dragStart = dragCurrent = {event.button.x, event.button.y};
                             isDragging = true;
                         }
                         break;
@@ -183,12 +3065,8 @@ public:
                         
                     case SDL_MOUSEMOTION:
                         if (isDragging) {
-                            double dx = (event.motion.x - dragStart.x) / (zoom * WINDOW_WIDTH/4.0);
-                            double dy = (event.motion.y - dragStart.y) / (zoom * WINDOW_WIDTH/4.0);
-                            centerX -= dx;
-                            centerY -= dy;
-                            dragStart = {event.motion.x, event.motion.y};
-                            renderMandelbrot();
+                            dragCurrent = {event.motion.x, event.motion.y};
+                            inputEvents++;
                         }
                         break;
                         
@@ -196,35 +3074,71 @@ public:
                         {
                             int mouseX, mouseY;
                             SDL_GetMouseState(&mouseX, &mouseY);
+                            zoomAnchor = {mouseX, mouseY};
+                            inputEvents++;
+                            // Every tick postpones the full-resolution frame,
+                            // also ticks that only retarget the animation
+                            lastInteraction = std::chrono::steady_clock::now();
                             
-                            double mouseWorldX = (mouseX - WINDOW_WIDTH/2.0) / (zoom * WINDOW_WIDTH/4.0) + centerX;
-                            double mouseWorldY = (mouseY - WINDOW_HEIGHT/2.0) / (zoom * WINDOW_WIDTH/4.0) + centerY;
-                            
-                            // Apply zooming in smaller steps for smoothness
-                            double targetZoom = event.wheel.y > 0 ? zoom * 1.1 : zoom / 1.1;
-                            double steps = 1;
-                            double currentZoom = zoom;
-                            
-                            while (std::abs(currentZoom - targetZoom) > 0.0001) {
-                                currentZoom = zoom + (targetZoom - zoom) * (steps / 10.0);
-                                zoom = currentZoom;
-                                
-                                centerX = mouseWorldX - (mouseX - WINDOW_WIDTH/2.0) / (zoom * WINDOW_WIDTH/4.0);
-                                centerY = mouseWorldY - (mouseY - WINDOW_HEIGHT/2.0) / (zoom * WINDOW_WIDTH/4.0);
-                                
-                                renderMandelbrot();
-                                steps++;
-                                if (steps > 10) break; // Ensure we don't loop forever
+                            // A tick during an animation only retargets it; the
+                            // next displayed frame takes the step
+                            const bool starting = !zoomAnimating;
+                            if (starting) {
+                                zoomTarget = zoom;
+                                // Take the first step now, as if one display frame had passed
+                                lastZoomStep = std::chrono::steady_clock::now() -
+                                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                        std::chrono::duration<double, std::milli>(DISPLAY_FRAME_MS));
+                            }
+                            zoomTarget *= std::pow(ZOOM_PER_NOTCH, event.wheel.y);
+                            zoomAnimating = true;
+                            if (starting) {
+                                stepZoomAnimation();
+                            }
+                        }
+                        break;
+                        
+                    default:
+                        if (event.type == frameReadyEvent) {
+                            presentFrame();
+                            // A step requests a new frame, which would cancel
+                            // the one a coarse pass is a preview of
+                            if (event.user.code == 0) break;
+                            if (zoomAnimating) {
+                                stepZoomAnimation();
+                            }
+                            if (colorCycling) {
+                                stepColorCycle();
                             }
                         }
                         break;
                 }
+            } while (running && SDL_PollEvent(&event));
+            
+            applyDrag();
+            if (running && viewChanged) {
+                viewChanged = false;
+                // Changes that arrive before the full-resolution frame is
+                // due, such as color cycling steps, keep the reduced resolution
+                requestRender(interactiveChange || fullResolutionPending);
+                if (interactiveChange) {
+                    lastInteraction = std::chrono::steady_clock::now();
+                    fullResolutionPending = true;
+                }
+                interactiveChange = false;
             }
         }
     }
 };
 
 int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        return MandelbrotExplorer::benchmark();
+    }
+    if (argc > 1 && std::string(argv[1]) == "--verify") {
+        return MandelbrotExplorer::verify();
+    }
+    
     try {
         MandelbrotExplorer().run();
     } catch (const std::exception& e) {